@@ -0,0 +1,135 @@
+#include <cstring>
+#include <cmath>
+#include "BinaryProtocol.hpp"
+
+FrameWriter::FrameWriter(std::string& out, Opcode op):out(out),start(out.size()){
+    putU32(0); // Patched by finish()
+    putU8((uint8_t)op);
+}
+
+void FrameWriter::putU8(uint8_t v) {
+    out.push_back((char)v);
+}
+
+void FrameWriter::putU32(uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back((char)(v >> (8 * i)));
+}
+
+void FrameWriter::putI32(int32_t v) {
+    putU32((uint32_t)v);
+}
+
+void FrameWriter::putF64(double v) {
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    for (int i = 0; i < 8; ++i) out.push_back((char)(bits >> (8 * i)));
+}
+
+void FrameWriter::putBytes(const char* data, size_t size) {
+    out.append(data, size);
+}
+
+void FrameWriter::putPoints(const Point* points, size_t count, PointFormat format) {
+    putU8((uint8_t)format);
+    putU32((uint32_t)count);
+    out.reserve(out.size() + count * (format == POINTS_I32 ? 8 : 16));
+    for (size_t i = 0; i < count; ++i) {
+        if (format == POINTS_I32) {
+            putI32((int32_t)points[i].x);
+            putI32((int32_t)points[i].y);
+        } else {
+            putF64(points[i].x);
+            putF64(points[i].y);
+        }
+    }
+}
+
+void FrameWriter::finish() {
+    uint32_t length = (uint32_t)(out.size() - start - FRAME_HEADER);
+    for (int i = 0; i < 4; ++i) out[start + i] = (char)(length >> (8 * i));
+}
+
+FrameReader::FrameReader(const char* body, size_t size):pos(body),end(body + size),failed(false){
+}
+
+uint8_t FrameReader::getU8() {
+    if (end - pos < 1) {
+        failed = true;
+        return 0;
+    }
+    return (uint8_t)*pos++;
+}
+
+uint32_t FrameReader::getU32() {
+    if (end - pos < 4) {
+        failed = true;
+        return 0;
+    }
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= (uint32_t)(uint8_t)pos[i] << (8 * i);
+    pos += 4;
+    return v;
+}
+
+int32_t FrameReader::getI32() {
+    return (int32_t)getU32();
+}
+
+double FrameReader::getF64() {
+    if (end - pos < 8) {
+        failed = true;
+        return 0;
+    }
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i) bits |= (uint64_t)(uint8_t)pos[i] << (8 * i);
+    pos += 8;
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+bool FrameReader::getPoints(std::vector<Point>& points) {
+    uint8_t format = getU8();
+    uint32_t count = getU32();
+    size_t width = format == POINTS_I32 ? 8 : 16;
+    if (failed || format > POINTS_I32 || remaining() / width < count) {
+        failed = true;
+        return false;
+    }
+    points.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (format == POINTS_I32) {
+            points[i].x = getI32();
+            points[i].y = getI32();
+        } else {
+            points[i].x = getF64();
+            points[i].y = getF64();
+            if (!std::isfinite(points[i].x) || !std::isfinite(points[i].y)) { // NaN has no place in the point order
+                failed = true;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+long nextFrame(const char* data, size_t available, Opcode& op, const char*& body, size_t& size) {
+    if (available < FRAME_HEADER) return 0;
+    FrameReader header(data, FRAME_HEADER);
+    uint32_t length = header.getU32();
+    if (length < 1 || length > FRAME_MAX) return -1;
+    if (available - FRAME_HEADER < length) return 0;
+    op = (Opcode)(uint8_t)data[FRAME_HEADER];
+    body = data + FRAME_HEADER + 1;
+    size = length - 1;
+    return FRAME_HEADER + length;
+}
+
+bool fitsInt32(const Point* points, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const Point& p = points[i];
+        if (p.x != std::trunc(p.x) || p.y != std::trunc(p.y)) return false;
+        if (std::abs(p.x) > 2147483647.0 || std::abs(p.y) > 2147483647.0) return false;
+    }
+    return true;
+}
@@ -0,0 +1,109 @@
+#ifndef BINARYPROTOCOL_HPP
+#define BINARYPROTOCOL_HPP
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "ConvexHall.hpp"
+
+// Framed binary messages, negotiated per connection: the client sends the text
+// command BINARY_HELLO, waits for the text reply, and from then on both sides
+// only exchange frames:
+//   uint32 length | uint8 opcode | body (length - 1 bytes)
+// All the numbers are little endian. A point array is
+//   uint8 format | uint32 count | count (x, y) pairs, as float64 or int32
+
+#define BINARY_HELLO "Binary"   // Text command that switches the connection to frames
+#define FRAME_HEADER 4          // Bytes of the length that starts every frame
+#define FRAME_MAX (64u << 20)   // Longest frame accepted, 64 MiB: about 4M float64 points
+
+typedef enum Opcode{
+    OP_TEXT = 1,         // Both ways: a text command, or the text response to a command
+    OP_NEWGRAPH = 2,     // Request: a point array, replaces the graph
+    OP_NEWPOINTS = 3,    // Request: a point array, added as one batch
+    OP_REMOVEPOINTS = 4, // Request: a point array, removed as one batch
+    OP_CH = 5,           // Request: no body
+    OP_HULL = 6          // Response to OP_CH: float64 area, then the hull as a point array
+} Opcode;
+
+typedef enum PointFormat{
+    POINTS_F64 = 0, // Two float64 per point
+    POINTS_I32 = 1  // Two int32 per point, for integer coordinates
+} PointFormat;
+
+/**
+ * @brief Appends frames to a byte string.
+ */
+class FrameWriter {
+    private:
+        std::string& out;
+        size_t start; // Where the open frame's length goes
+
+    public:
+        /**
+         * @brief Open a frame at the end of out.
+         */
+        FrameWriter(std::string& out, Opcode op);
+
+        void putU8(uint8_t v);
+        void putU32(uint32_t v);
+        void putI32(int32_t v);
+        void putF64(double v);
+        void putBytes(const char* data, size_t size);
+
+        /**
+         * @brief Append a point array, as int32 if format is POINTS_I32 (the coordinates must then be integers in range).
+         */
+        void putPoints(const Point* points, size_t count, PointFormat format);
+
+        /**
+         * @brief Write the length of the frame. Call once, after the body.
+         */
+        void finish();
+};
+
+/**
+ * @brief Reads the body of one frame. Every read past the end sets a failure instead of reading.
+ */
+class FrameReader {
+    private:
+        const char* pos;
+        const char* end;
+        bool failed;
+
+    public:
+        FrameReader(const char* body, size_t size);
+
+        uint8_t getU8();
+        uint32_t getU32();
+        int32_t getI32();
+        double getF64();
+
+        /**
+         * @brief Read a point array.
+         * @return false if the array is truncated, has an unknown format or a coordinate that is NaN or infinite.
+         */
+        bool getPoints(std::vector<Point>& points);
+
+        bool ok() const { return !failed; }
+        size_t remaining() const { return end - pos; }
+        const char* data() const { return pos; }
+};
+
+/**
+ * @brief Find the first complete frame in received bytes.
+ * @param data The bytes received and not consumed yet.
+ * @param available The number of bytes at data.
+ * @param op Receives the opcode.
+ * @param body Receives the start of the body, inside data.
+ * @param size Receives the size of the body.
+ * @return The size of the whole frame, 0 if it is not complete yet, or -1 if the length is invalid.
+ */
+long nextFrame(const char* data, size_t available, Opcode& op, const char*& body, size_t& size);
+
+/**
+ * @brief Whether every coordinate is an integer that fits an int32, so the points can be sent as POINTS_I32.
+ */
+bool fitsInt32(const Point* points, size_t count);
+
+#endif
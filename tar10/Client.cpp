@@ -4,9 +4,101 @@
 #include <unistd.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <sstream>
+#include <vector>
+#include "BinaryProtocol.hpp"
 #define PORT 9034
 #define BUFSIZE 4096
-int main(){
+
+/**
+ * @brief Send all the bytes, looping over partial sends.
+ * @return false if the connection failed.
+ */
+static bool sendAll(int sockfd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = send(sockfd, data, size, 0);
+        if (sent < 0) return false;
+        data += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+/**
+ * @brief Parse "n x1,y1 ... xn,yn" as the server does for Newgraph, Newpoints and Removepoints.
+ * @return false if the count is missing or negative, or if the list is short or malformed.
+ */
+static bool parsePoints(std::istringstream& iss, std::vector<Point>& points) {
+    int n = 0;
+    points.clear();
+    if (!(iss >> n) || n < 0) return false;
+    for (int i = 0; i < n; ++i) {
+        double x, y;
+        char comma;
+        if (!(iss >> x >> comma >> y)) return false; // Stop at the first bad point, as the server does
+        points.push_back(Point{x, y});
+    }
+    return true;
+}
+
+/**
+ * @brief Encode a command line as one frame: point arrays for the point commands, OP_TEXT for the rest.
+ * @return false if the point list of a point command is invalid; nothing is encoded then.
+ */
+static bool encodeCommand(const std::string& cmd, std::string& frame) {
+    std::istringstream iss(cmd);
+    std::string name;
+    iss >> name;
+    Opcode op = name == "Newgraph" ? OP_NEWGRAPH : name == "Newpoints" ? OP_NEWPOINTS :
+                name == "Removepoints" ? OP_REMOVEPOINTS : name == "CH" ? OP_CH : OP_TEXT;
+    std::vector<Point> points;
+    if (op != OP_TEXT && op != OP_CH && !parsePoints(iss, points)) {
+        std::cerr << "Invalid point list, expected: " << name << " n x1,y1 x2,y2 ... xn,yn" << std::endl;
+        return false;
+    }
+    FrameWriter writer(frame, op);
+    if (op == OP_TEXT) {
+        writer.putBytes(cmd.data(), cmd.size());
+    } else if (op != OP_CH) {
+        PointFormat format = fitsInt32(points.data(), points.size()) ? POINTS_I32 : POINTS_F64;
+        writer.putPoints(points.data(), points.size(), format);
+    }
+    writer.finish();
+    return true;
+}
+
+/**
+ * @brief Receive one frame and print it like the text protocol would.
+ * @return false if the connection is closed or the frame is invalid.
+ */
+static bool printFrame(int sockfd, std::string& pending) {
+    char buf[BUFSIZE];
+    Opcode op;
+    const char* body;
+    size_t size;
+    long used;
+    while ((used = nextFrame(pending.data(), pending.size(), op, body, size)) == 0) {
+        int nbytes = recv(sockfd, buf, BUFSIZE, 0);
+        if (nbytes <= 0) return false;
+        pending.append(buf, nbytes);
+    }
+    if (used < 0) return false;
+    if (op == OP_HULL) {
+        FrameReader reader(body, size);
+        double area = reader.getF64();
+        std::vector<Point> hull;
+        if (!reader.getPoints(hull)) return false;
+        std::cout << "Convex Hull Area: " << area << std::endl;
+        std::cout << "Convex Hull Points:\n";
+        for (const Point& p : hull) std::cout << "(" << p.x << ", " << p.y << ")\n";
+    } else {
+        std::cout.write(body, size);
+    }
+    pending.erase(0, used);
+    return true;
+}
+
+int main(int argc, char* argv[]){
     
     int sockfd;
     struct sockaddr_in serv_addr;
@@ -31,11 +123,37 @@ int main(){
 
     std::cout << "Connected to server on port " << PORT << std::endl;
 
+    bool binary = false;   // Frames after the Binary command, see BinaryProtocol.hpp
+    std::string pending;   // Received bytes of frames not printed yet
+    if (argc > 1 && std::string(argv[1]) == "--binary") {
+        std::string hello = BINARY_HELLO "\n";
+        int nbytes = -1;
+        if (sendAll(sockfd, hello.c_str(), hello.size())) nbytes = recv(sockfd, buf, BUFSIZE - 1, 0);
+        if (nbytes <= 0) {
+            std::cerr << "Server closed connection or error." << std::endl;
+            close(sockfd);
+            return 1;
+        }
+        buf[nbytes] = '\0';
+        std::cout << buf;
+        binary = true;
+    }
+
     std::cout << "Available commands:" << std::endl;
+    std::cout << "  Use name" << std::endl;
     std::cout << "  Newgraph n x1,y1 x2,y2 ... xn,yn" << std::endl;
     std::cout << "  CH" << std::endl;
+    std::cout << "  Contains x,y" << std::endl;
+    std::cout << "  ContainsBatch n x1,y1 x2,y2 ... xn,yn" << std::endl;
+    std::cout << "  Diameter" << std::endl;
+    std::cout << "  Width" << std::endl;
+    std::cout << "  MinRect" << std::endl;
+    std::cout << "  Perimeter" << std::endl;
     std::cout << "  Newpoint x,y" << std::endl;
+    std::cout << "  Newpoints n x1,y1 x2,y2 ... xn,yn" << std::endl;
     std::cout << "  Removepoint x,y" << std::endl;
+    std::cout << "  Removepoints n x1,y1 x2,y2 ... xn,yn" << std::endl;
+    std::cout << "  Binary" << std::endl;
     std::cout << "  exit" << std::endl;
 
     while (true) {
@@ -43,7 +161,23 @@ int main(){
         std::cout << "> ";
         if (!std::getline(std::cin, cmd)) break;
 
-        if (send(sockfd, cmd.c_str(), cmd.size(), 0) < 0) {
+        if (binary) {
+            std::string frame;
+            if (!encodeCommand(cmd, frame)) continue; // Not sent, as the server would refuse it
+            if (!sendAll(sockfd, frame.data(), frame.size())) {
+                std::cerr << "Error sending command." << std::endl;
+                break;
+            }
+            if (cmd == "exit") break;
+            if (!printFrame(sockfd, pending)) {
+                std::cerr << "Server closed connection or error." << std::endl;
+                break;
+            }
+            continue;
+        }
+
+        std::string line = cmd + "\n"; // The server runs a command once its '\n' arrives
+        if (!sendAll(sockfd, line.c_str(), line.size())) {
             std::cerr << "Error sending command." << std::endl;
             break;
         }
@@ -56,6 +190,7 @@ int main(){
         }
         buf[nbytes] = '\0';
         std::cout << buf;
+        if (cmd == BINARY_HELLO) binary = true;
     }
 
     close(sockfd);
@@ -0,0 +1,71 @@
+#include <charconv>
+#include <cmath>
+#include "CommandParser.hpp"
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+CommandParser::CommandParser(const char* begin, const char* end):pos(begin),end(end),failed(false){
+}
+
+CommandParser::CommandParser(std::string_view line):CommandParser(line.data(), line.data() + line.size()){
+}
+
+void CommandParser::skipSpaces() {
+    while (pos < end && isSpace(*pos)) ++pos;
+}
+
+std::string_view CommandParser::word() {
+    skipSpaces();
+    const char* start = pos;
+    while (pos < end && !isSpace(*pos)) ++pos;
+    return std::string_view(start, pos - start);
+}
+
+/**
+ * @brief from_chars on the next token, which may start with a '+' unlike what from_chars accepts.
+ */
+template <typename T>
+static bool parseNumber(const char*& pos, const char* end, bool& failed, T& value) {
+    value = 0;
+    if (failed) return false;
+    const char* start = pos;
+    if (start < end && *start == '+' && start + 1 < end && start[1] != '-') ++start;
+    auto result = std::from_chars(start, end, value);
+    if (result.ec != std::errc()) {
+        value = 0;
+        failed = true;
+        return false;
+    }
+    pos = result.ptr;
+    return true;
+}
+
+bool CommandParser::number(double& value) {
+    skipSpaces();
+    if (!parseNumber(pos, end, failed, value)) return false;
+    if (!std::isfinite(value)) { // from_chars takes "nan" and "inf", stream extraction did not
+        value = 0;
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool CommandParser::number(int& value) {
+    skipSpaces();
+    return parseNumber(pos, end, failed, value);
+}
+
+bool CommandParser::point(double& x, double& y) {
+    y = 0;
+    if (!number(x)) return false;
+    skipSpaces();
+    if (pos == end) { // No separator
+        failed = true;
+        return false;
+    }
+    ++pos;
+    return number(y);
+}
@@ -0,0 +1,50 @@
+#ifndef COMMANDPARSER_HPP
+#define COMMANDPARSER_HPP
+#include <string_view>
+#include <cstddef>
+
+#define POINT_MIN_CHARS 4 // "x,y" and a space: the fewest characters a point of a point list takes
+
+/**
+ * @brief Reads the words and numbers of one command line in place, straight from the receive buffer.
+ *
+ * Numbers are parsed with std::from_chars, so there is no locale and nothing is
+ * allocated. The rules follow the stream extraction the commands used before:
+ * tokens are separated by whitespace, a point is "x,y" where the separator is
+ * any one character, "nan" and "inf" are not numbers, and after the first failed
+ * read every read fails and gives 0.
+ */
+class CommandParser {
+    private:
+        const char* pos;
+        const char* end;
+        bool failed;
+
+        void skipSpaces();
+
+    public:
+        CommandParser(const char* begin, const char* end);
+        explicit CommandParser(std::string_view line);
+
+        /**
+         * @brief The next run of non-space characters, empty at the end of the line.
+         */
+        std::string_view word();
+
+        bool number(double& value);
+        bool number(int& value);
+
+        /**
+         * @brief Read "x,y".
+         */
+        bool point(double& x, double& y);
+
+        bool ok() const { return !failed; }
+
+        /**
+         * @brief Characters left on the line, a bound on what a count read from it can describe.
+         */
+        size_t remaining() const { return end - pos; }
+};
+
+#endif
@@ -10,58 +10,108 @@
 #include <sstream>
 #include <condition_variable>
 #include "ConvexHall.hpp"
+#include "DynamicHull.hpp"
+#include "PointsSoA.hpp"
+#include "HullEngines.hpp"
+#include "RadixSort.hpp"
+#include "ThreadPool.hpp"
+#include "QuantizedPoints.hpp"
+#include "HullArena.hpp"
+#include "HullDispatcher.hpp"
+#include "SortedPoints.hpp"
+#include "HullQueries.hpp"
+#include "SlidingHull.hpp"
+#include "GraphRegistry.hpp"
+#include "BinaryProtocol.hpp"
+#include "CommandParser.hpp"
 #include "../tar5_8/ReactorProactor.hpp"
 #include <set>
+#include <deque>
+#include <atomic>
 
 #define PORT 9034
 #define MAX_CLIENTS 10
 #define BUFSIZE 4096
+#define TEXT_LINE_MAX (64u << 20) // Longest text line a connection may buffer, as FRAME_MAX for frames
 
 pthread_cond_t cond = PTHREAD_COND_INITIALIZER; 
 pthread_mutex_t area_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-ConvexHull graph;
-ConvexHull hull;
-std::mutex graph_mutex;
-bool runningServer = true;
-bool area_updated=false;
+HullOptions hull_options;
+GraphRegistry graphs; // The named graphs, each behind its own lock
+/**
+ * @brief A hull area that crossed the threshold, for wait_for_CH_area_change to report.
+ */
+typedef struct AreaEvent{
+    std::string graph;
+    double area;
+    bool above; // Reached the threshold, or fell below it
+} AreaEvent;
+
+std::deque<AreaEvent> area_events; // Crossings not reported yet, of every graph (under area_mutex)
+thread_local std::shared_ptr<GraphState> current_graph; // Graph selected by Use; every connection has its own thread
+thread_local bool binary_session = false; // Set after BINARY_HELLO: the connection only exchanges frames
+std::atomic<bool> runningServer{true}; // Cleared by exit on stdin, polled by every thread
 std::set<int> client_sockets;
 
 double polygonArea(const ConvexHull& poly) {
-    double area = 0;
-    int n = poly.size;
-    for (int i = 0; i < n; ++i) {
-        const Point& p1 = poly.points[i];
-        const Point& p2 = poly.points[(i + 1) % n];
-        area += (p1.x * p2.y) - (p2.x * p1.y);
-    }
-  
-    return std::abs(area) / 2.0;
+    static thread_local PointsSoA soa; // Reused, so CH doesn't allocate for the area
+    toSoA(poly.points, soa);
+    return shoelaceArea(soa);
 }
 
-void convexHull(std::vector<Point> points, ConvexHull& hull) {
-    if(points.empty()) {
+void convexHull(const std::vector<Point>& input, ConvexHull& hull) {
+    if(input.empty()) {
+        hull.points.clear();
         hull.size = 0;
         hull.area = 0.0;
         return; // No points to form a convex hull
     }
-    int n = points.size();
-    int k = 0;
-    std::sort(points.begin(), points.end()); // Sort points (by x, then by y)
-    hull.points.resize(2 * n); // Prepare space for the convex hull points
-    hull.size = 2 * n;
-      for (int i = 0; i < n; ++i) { // Build lower hull
-        while (k >= 2 && cross(hull.points[k-2], hull.points[k-1], points[i]) <= 0) k--;
-        hull.points[k++] = points[i];
+    HullChoice choice = hull_options.engine == ENGINE_AUTO ? chooseHullEngine(input) : CHOICE_SERIAL;
+    if (choice == CHOICE_PRESORTED) {
+        monotoneChain(input.data(), input.size(), hull);
+        return;
     }
-    for (int i = n-2, t = k+1; i >= 0; --i) { // Build upper hull
-        while (k >= t && cross(hull.points[k-2], hull.points[k-1], points[i]) <= 0) k--;
-        hull.points[k++] = points[i];
+    HullArena& arena = HullArena::local();
+    std::vector<Point>& points = arena.load(input);
+    if (hull_options.prefilter) {
+        size_t discarded = aklToussaintFilter(points);
+        std::cout << "Prefilter discarded " << discarded << " of " << points.size() << " points." << std::endl;
+        points.resize(points.size() - discarded);
     }
-    hull.points.resize(k - 1); // Remove the last point as it is the same as the first one
-    hull.size = k - 1;
+    if (hull_options.engine == ENGINE_QUICKHULL) {
+        choice = CHOICE_QUICKHULL;
+    } else if (hull_options.engine == ENGINE_MONOTONE && hull_options.threads > 1 && points.size() >= hull_options.parallel_cutoff) {
+        choice = CHOICE_PARALLEL;
+    }
+    if (choice == CHOICE_QUICKHULL) {
+        convexHull_QuickHull(points, hull);
+    } else if (choice == CHOICE_PARALLEL) {
+        convexHullParallel(points, hull, hull_options.threads);
+    } else {
+        arena.hull(hull); // Sort and chain in place (by x, then by y)
+    }
+}
 
-    printConvexHull(hull, std::cout);
+void convexHull(const PointSpan* spans, size_t count, ConvexHull& hull) {
+    size_t n = 0;
+    for (size_t s = 0; s < count; ++s) n += spans[s].size;
+    HullChoice choice = chooseSortedHullEngine(n);
+    if (choice == CHOICE_PARALLEL) {
+        convexHullParallel(spans, count, hull, hull_options.threads);
+    } else if (choice == CHOICE_QUICKHULL) {
+        std::vector<Point> points;
+        points.reserve(n);
+        for (size_t s = 0; s < count; ++s) points.insert(points.end(), spans[s].data, spans[s].data + spans[s].size);
+        convexHull_QuickHull(std::move(points), hull);
+    } else if (hull_options.prefilter && n > 0) {
+        static thread_local std::vector<Point> kept; // Reused like the arena
+        size_t discarded = aklToussaintFilter(spans, count, kept);
+        std::cout << "Prefilter discarded " << discarded << " of " << n << " points." << std::endl;
+        monotoneChain(kept.data(), kept.size(), hull);
+    } else {
+        monotoneChain(spans, count, hull);
+    }
 }
 
 double cross(const Point& p1, const Point& p2, const Point& p3) {
@@ -75,84 +125,471 @@ void printConvexHull(const ConvexHull& hull, std::ostream& os) {
     }
 }
 
-void readPoints(ConvexHull& graph, int n, std::istringstream& iss) {
-    graph.points.clear();
-    graph.area = 0.0;
-    hull.treshhold=false;
-    hull.points.clear();
-    hull.area = 0.0;
-    graph.size = n;
+/**
+ * @brief Print the points of the graph (in sorted order), from the quantized store when it is enabled,
+ * or from the window (oldest first) in window mode.
+ */
+static void printGraph(const GraphState& g, std::ostream& os) {
+    if (g.window_graph.enabled()) {
+        ConvexHull live;
+        g.window_graph.toPoints(live.points);
+        printConvexHull(live, os);
+        return;
+    }
+    if (!g.quantized_graph.enabled()) {
+        os << "Convex Hull Points:\n";
+        g.graph_points.forEach([&](const Point& point) { os << "(" << point.x << ", " << point.y << ")\n"; });
+        return;
+    }
+    ConvexHull snapped;
+    g.quantized_graph.toPoints(snapped.points);
+    printConvexHull(snapped, os);
+}
+
+/**
+ * @brief Store a parsed point in the quantized graph.
+ * @return false if the quantized store can't represent it.
+ */
+static bool storeQuantized(GraphState& g, double x, double y) {
+    if (g.quantized_graph.add(x, y)) return true;
+    std::cerr << "Point (" << x << ", " << y << ") is out of range for the quantized coordinates." << std::endl;
+    return false;
+}
+
+/**
+ * @brief Drop the points that left the window.
+ */
+static void expireWindow(GraphState& g) {
+    if (!g.window_graph.enabled() || g.window_graph.expire() == 0) return;
+    g.graph.size = g.window_graph.size();
+    g.graph.version++;
+    g.hull.version++;
+}
+
+/**
+ * @brief Bring the hull up to date with the graph and publish it as a new snapshot.
+ * The writers call it at the end of every change, so the readers only ever load the
+ * last snapshot. Expires the window first in window mode. Does nothing while the
+ * published snapshot is of the current hull.version. Call with g.mutex held.
+ */
+static void refreshHull(GraphState& g) {
+    expireWindow(g);
+    std::shared_ptr<const HullSnapshot> published = std::atomic_load(&g.snapshot);
+    if (published && published->version == g.hull.version) return;
+    if (g.window_graph.enabled()) {
+        g.window_graph.hull(g.hull); // From the window's chunk hulls, not from every live point
+    } else if (g.quantized_graph.enabled()) {
+        g.quantized_graph.hull(g.hull); // Exact integer chain over the fixed point store
+    } else {
+        if (!g.dynamic_hull.isValid()) {
+            g.dynamic_hull.rebuild(g.graph_points); // Linear chain over the sorted graph
+        }
+        g.dynamic_hull.toHull(g.hull);
+    }
+    printConvexHull(g.hull, std::cout);
+    g.hull.area = polygonArea(g.hull);
+
+    std::ostringstream body;
+    body << "Convex Hull Area: " << g.hull.area << std::endl;
+    printConvexHull(g.hull, body);
+    std::shared_ptr<HullSnapshot> snapshot = std::make_shared<HullSnapshot>();
+    snapshot->version = g.hull.version;
+    snapshot->hull = g.hull;
+    snapshot->response = body.str();
+    std::atomic_store(&g.snapshot, std::shared_ptr<const HullSnapshot>(snapshot));
+
+    bool above = g.hull.area >= 100;
+    if (above != g.hull.treshhold) { // The threshold state is the graph's, checked under its lock
+        g.hull.treshhold = above;
+        pthread_mutex_lock(&area_mutex);
+        area_events.push_back(AreaEvent{g.name, g.hull.area, above});
+        pthread_cond_signal(&cond);
+        pthread_mutex_unlock(&area_mutex);
+    }
+}
+
+/**
+ * @brief Replace the points of a graph.
+ * @param points The new points; snapped to the stored point of their cell with --match-epsilon.
+ */
+static void loadGraph(GraphState& g, std::vector<Point>& points) {
+    g.graph_points.clear();
+    g.point_index.clear();
+    g.quantized_graph.clear();
+    g.window_graph.clear();
+    g.graph.area = 0.0;
+    g.hull.treshhold=false;
+    g.hull.points.clear();
+    g.hull.area = 0.0;
+    g.dynamic_hull.invalidate(); // Rebuilt on the next CH
+    size_t duplicates = 0;
+    if (g.window_graph.enabled()) {
+        for (const Point& p : points) g.window_graph.add(p);
+    } else if (g.quantized_graph.enabled()) {
+        for (const Point& p : points) storeQuantized(g, p.x, p.y);
+    } else {
+        g.point_index.reserve(points.size());
+        for (Point& p : points) {
+            if (g.point_index.insert(p) > 0) duplicates++;
+        }
+        if (g.graph_points.assign(points)) { // Sorted once, unless it already is
+            std::cout << "Points are already sorted, skipped the sort." << std::endl;
+        }
+    }
+    if (duplicates > 0) {
+        std::cout << duplicates << " duplicate points in the new graph." << std::endl;
+    }
+    g.window_graph.expire(); // Only the last N points are kept
+    g.graph.size = g.window_graph.enabled() ? g.window_graph.size() : g.quantized_graph.enabled() ? g.quantized_graph.size() : g.graph_points.size();
+    g.graph.version++;
+    g.hull.version++;
+    refreshHull(g);
+}
+
+bool readPoints(GraphState& g, int n, CommandParser& parser) {
+    if (n < 0) return false;
+    std::vector<Point> parsed;
+    parsed.reserve(std::min<size_t>(n, parser.remaining() / POINT_MIN_CHARS + 1)); // n comes from the client, the line bounds it
     for (int i = 0; i < n; ++i) {
     //std::cout << "Enter coordinates for point " << i + 1 << " (x y): ";
         double x, y;
-        char comma;
-        iss >> x >> comma >> y;
-        graph.points.push_back(Point{x, y});
+        if (!parser.point(x, y)) return false; // The graph is left as it was
+        parsed.push_back(Point{x, y});
     }
-    graph.size = graph.points.size();
-    printConvexHull(graph, std::cout);
+    loadGraph(g, parsed);
+    printGraph(g, std::cout);
+    return true;
 }
 
-void addPoint(ConvexHull& graph, std::istringstream& iss) {
+/**
+ * @brief What storing or removing one point did.
+ */
+typedef struct PointEdit{
+    bool applied;    // The graph changed
+    bool hull_moved; // The change can move the hull
+    size_t copies;   // Copies of the point the graph already held (insertions in the default store)
+} PointEdit;
+
+/**
+ * @brief Store one point, without touching the versions (see finishEdit).
+ */
+static PointEdit insertPoint(GraphState& g, double x, double y) {
+    PointEdit edit = {false, false, 0};
+    if (g.window_graph.enabled()) {
+        g.window_graph.add(Point{x, y});
+        edit.applied = edit.hull_moved = true;
+    } else if (g.quantized_graph.enabled()) {
+        edit.applied = edit.hull_moved = storeQuantized(g, x, y);
+    } else {
+        Point p{x, y};
+        edit.copies = g.point_index.insert(p); // p becomes the stored point of its cell with --match-epsilon
+        g.graph_points.insert(p);
+        edit.applied = true;
+        edit.hull_moved = g.dynamic_hull.insert(p); // An interior point keeps the hull, and the published snapshot, as they are
+    }
+    return edit;
+}
+
+/**
+ * @brief Remove one copy of a point, without touching the versions (see finishEdit).
+ * Not available in window mode.
+ */
+static PointEdit deletePoint(GraphState& g, double x, double y) {
+    PointEdit edit = {false, false, 0};
+    if (g.quantized_graph.enabled()) {
+        edit.applied = edit.hull_moved = g.quantized_graph.remove(x, y);
+    } else if (!g.window_graph.enabled()) {
+        Point stored;
+        size_t left;
+        if (g.point_index.erase(Point{x, y}, stored, left)) { // Misses never touch the sorted store
+            g.graph_points.eraseOne(stored);
+            edit.applied = true;
+            // Removing a point that is not a vertex, or one copy of it, keeps the hull
+            edit.hull_moved = left == 0 && g.dynamic_hull.erase(stored, g.graph_points);
+        }
+    }
+    return edit;
+}
+
+/**
+ * @brief Close a series of edits: expire the window, bump the versions once and publish them.
+ * @param hull_moved Whether any of the edits can have moved the hull.
+ */
+static void finishEdit(GraphState& g, bool hull_moved) {
+    if (g.window_graph.enabled()) {
+        g.window_graph.expire();
+        g.graph.size = g.window_graph.size();
+    } else {
+        g.graph.size = g.quantized_graph.enabled() ? g.quantized_graph.size() : g.graph_points.size();
+    }
+    g.graph.version++;
+    if (hull_moved) g.hull.version++;
+    refreshHull(g); // An edit that kept the hull keeps the published snapshot too
+}
+
+void addPoint(GraphState& g, CommandParser& parser, std::ostream& os) {
     double x, y;
-    char comma;
-    iss >> x >> comma >> y;
-    graph.points.push_back(Point{x, y});
-    graph.size = graph.points.size();
-    printConvexHull(graph, std::cout);
+    parser.point(x, y);
+    PointEdit edit = insertPoint(g, x, y);
+    if (edit.copies > 0) {
+        os << "Point (" << x << ", " << y << ") is already in the graph (" << edit.copies << (edit.copies == 1 ? " copy" : " copies") << ")." << std::endl;
+    }
+    if (edit.applied) finishEdit(g, edit.hull_moved);
+    printGraph(g, std::cout);
 }
 
-void removePoint(ConvexHull& graph, std::istringstream& iss,std::ostream& os) {
+void removePoint(GraphState& g, CommandParser& parser, std::ostream& os) {
     double x, y;
-    char comma;
-    bool validInput = false;
-    iss >> x >> comma >> y;
-    auto it = std::remove_if(graph.points.begin(), graph.points.end(),
-        [&](const Point& p) { return p.x == x && p.y == y; });
-    if (it != graph.points.end()) {
-        graph.points.erase(it, graph.points.end());
-        graph.size = graph.points.size();
-        validInput = true;
-    }
-    if (!validInput) {
+    parser.point(x, y);
+    if (g.window_graph.enabled()) {
+        std::cerr << "Removepoint is not available in window mode, points expire from the window." << std::endl;
+        os << "Removepoint is not available in window mode, points expire from the window." << std::endl;
+        printGraph(g, std::cout);
+        return;
+    }
+    PointEdit edit = deletePoint(g, x, y);
+    if (edit.applied) {
+        finishEdit(g, edit.hull_moved);
+    } else {
         std::cerr << "Point (" << x << ", " << y << ") not found in the graph." << std::endl;
         os << "Point (" << x << ", " << y << ") not found in the graph." << std::endl;
     }
-    printConvexHull(graph, std::cout);
+    printGraph(g, std::cout);
+}
+
+/**
+ * @brief Read the "n x1,y1 ..." of a batch command.
+ * @return false if the count is missing or negative, or a point fails to parse before n of them.
+ */
+static bool readBatch(CommandParser& parser, std::vector<Point>& points) {
+    int n;
+    points.clear();
+    if (!parser.number(n) || n < 0) return false;
+    for (int i = 0; i < n; ++i) {
+        double x, y;
+        if (!parser.point(x, y)) return false; // Stop at the end of what was sent, whatever n says
+        points.push_back(Point{x, y});
+    }
+    return true;
+}
+
+/**
+ * @brief Add a batch of points with one version bump and print a one line summary.
+ */
+static void insertBatch(GraphState& g, const std::vector<Point>& points, std::ostream& os) {
+    size_t added = 0, duplicates = 0;
+    bool hull_moved = false;
+    for (const Point& p : points) {
+        PointEdit edit = insertPoint(g, p.x, p.y);
+        added += edit.applied;
+        duplicates += edit.copies > 0;
+        hull_moved |= edit.hull_moved;
+    }
+    if (added > 0) finishEdit(g, hull_moved);
+    std::ostringstream summary;
+    summary << "Added " << added << " of " << points.size() << " points (" << duplicates << " duplicates), "
+            << g.graph.size << " points in the graph." << std::endl;
+    std::cout << summary.str();
+    os << summary.str();
+}
+
+/**
+ * @brief Remove one copy of each point of a batch with one version bump and print a one line summary.
+ */
+static void deleteBatch(GraphState& g, const std::vector<Point>& points, std::ostream& os) {
+    if (g.window_graph.enabled()) {
+        std::cerr << "Removepoints is not available in window mode, points expire from the window." << std::endl;
+        os << "Removepoints is not available in window mode, points expire from the window." << std::endl;
+        return;
+    }
+    size_t removed = 0;
+    bool hull_moved = false;
+    for (const Point& p : points) {
+        PointEdit edit = deletePoint(g, p.x, p.y);
+        removed += edit.applied;
+        hull_moved |= edit.hull_moved;
+    }
+    if (removed > 0) finishEdit(g, hull_moved);
+    std::ostringstream summary;
+    summary << "Removed " << removed << " of " << points.size() << " points (" << (points.size() - removed) << " not found), "
+            << g.graph.size << " points in the graph." << std::endl;
+    std::cout << summary.str();
+    os << summary.str();
+}
+
+void addPoints(GraphState& g, CommandParser& parser, std::ostream& os) {
+    std::vector<Point> points;
+    if (!readBatch(parser, points)) {
+        os << "Invalid point list, expected: Newpoints n x1,y1 x2,y2 ... xn,yn" << std::endl;
+        return;
+    }
+    insertBatch(g, points, os);
 }
 
-void handle_request(const std::string& request, int client_socket, ConvexHull& graph, ConvexHull& hull) {
-    std::istringstream iss(request);
+void removePoints(GraphState& g, CommandParser& parser, std::ostream& os) {
+    std::vector<Point> points;
+    if (!readBatch(parser, points)) {
+        os << "Invalid point list, expected: Removepoints n x1,y1 x2,y2 ... xn,yn" << std::endl;
+        return;
+    }
+    deleteBatch(g, points, os);
+}
+
+/**
+ * @brief The last hull a writer published, without taking g.mutex.
+ * A reader never rebuilds the hull and never waits for a writer: while an edit is in
+ * progress it gets the snapshot from before it. Two cases take the lock and refresh:
+ * a graph that nothing has been written to yet, and --window-seconds, where points expire
+ * with the clock and no writer would notice.
+ * std::atomic_load on a shared_ptr is not lock free in libstdc++: it takes one of a few
+ * internal mutexes picked by address, held only to copy the pointer and its count.
+ */
+static std::shared_ptr<const HullSnapshot> currentSnapshot(GraphState& g) {
+    if (!g.window_graph.expiresByTime()) {
+        std::shared_ptr<const HullSnapshot> snapshot = std::atomic_load(&g.snapshot);
+        if (snapshot) return snapshot;
+    }
+    std::lock_guard<std::mutex> lock(g.mutex);
+    refreshHull(g);
+    return std::atomic_load(&g.snapshot);
+}
+
+/**
+ * @brief Answer "Contains x,y": whether the point is inside the current hull (or on its boundary).
+ */
+static void containsPoint(GraphState& g, CommandParser& parser, std::ostream& os) {
+    double x, y;
+    parser.point(x, y);
+    bool inside = hullContains(currentSnapshot(g)->hull.points, Point{x, y});
+    os << "Point (" << x << ", " << y << ") is " << (inside ? "inside" : "outside") << " the convex hull." << std::endl;
+}
+
+/**
+ * @brief Answer "ContainsBatch n x1,y1 ...": one 1 (inside or on the boundary) or 0 per point, in order.
+ */
+static void containsBatch(GraphState& g, CommandParser& parser, std::ostream& os) {
+    static thread_local PointsSoA queries;
+    static thread_local std::vector<char> inside;
+    int n;
+    queries.x.clear();
+    queries.y.clear();
+    if (!parser.number(n) || n < 0) {
+        os << "Invalid point list, expected: ContainsBatch n x1,y1 x2,y2 ... xn,yn" << std::endl;
+        return;
+    }
+    size_t cap = std::min<size_t>(n, parser.remaining() / POINT_MIN_CHARS + 1); // n comes from the client, the line bounds it
+    queries.x.reserve(cap);
+    queries.y.reserve(cap);
+    for (int i = 0; i < n; ++i) {
+        double x, y;
+        if (!parser.point(x, y)) {
+            os << "Invalid point list, expected: ContainsBatch n x1,y1 x2,y2 ... xn,yn" << std::endl;
+            return;
+        }
+        queries.x.push_back(x);
+        queries.y.push_back(y);
+    }
+    hullContainsBatch(currentSnapshot(g)->hull.points, queries, inside);
+    size_t count = std::count(inside.begin(), inside.end(), 1);
+    os << count << " of " << queries.size() << " points inside the convex hull: ";
+    for (char c : inside) os << (c ? '1' : '0');
+    os << std::endl;
+}
+
+/**
+ * @brief Send all the bytes, looping over partial sends.
+ */
+static void sendAll(int client_socket, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = send(client_socket, data, size, MSG_NOSIGNAL);
+        if (sent <= 0) return; // The client is gone, its thread sees it on the next recv
+        data += sent;
+        size -= sent;
+    }
+}
+
+/**
+ * @brief Send a text response to stdin's console or to a client, in an OP_TEXT frame on a binary connection.
+ */
+static void sendReply(int client_socket, const std::string& out) {
+    if (client_socket == 1) {
+        std::cout << out;
+    } else if (binary_session) {
+        std::string frame;
+        FrameWriter writer(frame, OP_TEXT);
+        writer.putBytes(out.data(), out.size());
+        writer.finish();
+        sendAll(client_socket, frame.data(), frame.size());
+    } else {
+        sendAll(client_socket, out.data(), out.size());
+    }
+}
+
+void handle_request(std::string_view request, int client_socket) {
+    CommandParser parser(request); // Reads the request where it is, nothing is copied
     std::ostringstream response;
-    std::string cmd;
-    iss >> cmd;
-    if (cmd == "Newgraph") {
-        std::lock_guard<std::mutex> lock(graph_mutex); // Lock the mutex to ensure thread safety
+    std::shared_ptr<const HullSnapshot> snapshot; // Set when the reply is the CH response of a snapshot
+    std::string_view cmd = parser.word();
+    if (!current_graph) current_graph = graphs.get(DEFAULT_GRAPH);
+    GraphState& g = *current_graph;
+    if (cmd == "Use") {
+        std::string_view name = parser.word();
+        if (name.empty()) {
+            response << "Usage: Use <name>" << std::endl;
+        } else {
+            current_graph = graphs.get(std::string(name)); // Created empty on first use
+            response << "Using graph " << name << "." << std::endl;
+        }
+    } else if (cmd == "Newgraph") {
+        std::lock_guard<std::mutex> lock(g.mutex); // Lock the graph to ensure thread safety
         int n;
-        iss >> n;
-        readPoints(graph, n, iss);
-        printConvexHull(graph, response);
+        if (parser.number(n) && readPoints(g, n, parser)) {
+            printGraph(g, response);
+        } else {
+            response << "Invalid point list, expected: Newgraph n x1,y1 x2,y2 ... xn,yn" << std::endl;
+        }
     } else if (cmd == "CH") {
-        std::lock_guard<std::mutex> lock(graph_mutex);
-        convexHull(graph.points, hull);
-        hull.area = polygonArea(hull);
-        response << "Convex Hull Area: " << hull.area << std::endl;
-        printConvexHull(hull, response);
-
-
-        pthread_mutex_lock(&area_mutex);
-        area_updated=true;
-        pthread_cond_signal(&cond);
-        pthread_mutex_unlock(&area_mutex);
-        
+        snapshot = currentSnapshot(g);
+    } else if (cmd == "Contains") {
+        containsPoint(g, parser, response);
+    } else if (cmd == "ContainsBatch") {
+        containsBatch(g, parser, response);
+    } else if (cmd == "Diameter") {
+        std::shared_ptr<const HullSnapshot> current = currentSnapshot(g);
+        const HullMetrics& m = current->metrics();
+        response << "Diameter: " << m.diameter << " between (" << m.diameter_ends[0].x << ", " << m.diameter_ends[0].y
+                 << ") and (" << m.diameter_ends[1].x << ", " << m.diameter_ends[1].y << ")" << std::endl;
+    } else if (cmd == "Width") {
+        response << "Minimum width: " << currentSnapshot(g)->metrics().width << std::endl;
+    } else if (cmd == "MinRect") {
+        std::shared_ptr<const HullSnapshot> current = currentSnapshot(g);
+        const HullMetrics& m = current->metrics();
+        response << "Minimum area rectangle: " << m.rect_area << std::endl;
+        for (const Point& corner : m.rect) {
+            response << "(" << corner.x << ", " << corner.y << ")\n";
+        }
+    } else if (cmd == "Perimeter") {
+        response << "Perimeter: " << currentSnapshot(g)->metrics().perimeter << std::endl;
     } else if (cmd == "Newpoint") {
-        std::lock_guard<std::mutex> lock(graph_mutex);
-        addPoint(graph, iss);
-        printConvexHull(graph, response);
+        std::lock_guard<std::mutex> lock(g.mutex);
+        addPoint(g, parser, response);
+        printGraph(g, response);
+    } else if (cmd == "Newpoints") {
+        std::lock_guard<std::mutex> lock(g.mutex); // Once for the whole batch
+        addPoints(g, parser, response);
+    } else if (cmd == "Removepoints") {
+        std::lock_guard<std::mutex> lock(g.mutex);
+        removePoints(g, parser, response);
     } else if (cmd == "Removepoint") {
-        std::lock_guard<std::mutex> lock(graph_mutex);
-        removePoint(graph, iss, response);
-        printConvexHull(graph, response); 
+        std::lock_guard<std::mutex> lock(g.mutex);
+        removePoint(g, parser, response);
+        printGraph(g, response); 
+    } else if (cmd == BINARY_HELLO) {
+        if (client_socket == 1) {
+            response << "Binary mode is only for client connections." << std::endl;
+        } else {
+            response << "Binary mode on." << std::endl; // Still sent as text, frames start after it
+        }
     } else if (cmd == "exit") {
         response << "Exiting server." << std::endl;
         if (client_socket == 1) { // If the request is from stdin (client_socket == 1), stop the reactor
@@ -162,16 +599,56 @@ void handle_request(const std::string& request, int client_socket, ConvexHull& g
         } 
     } else {
         response << "Unknown command: " << request << std::endl;
-        response << "Available commands: Newgraph, CH, Newpoint, Removepoint, exit" << std::endl;
+        response << "Available commands: Use, Newgraph, CH, Contains, ContainsBatch, Diameter, Width, MinRect, Perimeter, Newpoint, Newpoints, Removepoint, Removepoints, Binary, exit" << std::endl;
     }
 
-    std::string out = response.str();
-    if (client_socket == 1) {
-        std::cout << out;
+    std::string built = snapshot ? std::string() : response.str();
+    const std::string& out = snapshot ? snapshot->response : built;
+    sendReply(client_socket, out);
+    if (cmd == BINARY_HELLO && client_socket != 1) binary_session = true;
+}
+
+/**
+ * @brief Handle one frame of a binary connection.
+ * Points come in and the hull goes out as raw arrays; anything else goes through
+ * handle_request as an OP_TEXT command and its response comes back in an OP_TEXT frame.
+ */
+static void handle_frame(Opcode op, const char* body, size_t size, int client_socket) {
+    if (op == OP_TEXT) {
+        if (size > 0 && body[size - 1] == '\n') size--;
+        handle_request(std::string_view(body, size), client_socket);
+        return;
+    }
+    if (!current_graph) current_graph = graphs.get(DEFAULT_GRAPH);
+    GraphState& g = *current_graph;
+    FrameReader reader(body, size);
+    std::vector<Point> points;
+    std::ostringstream response;
+    if (op == OP_CH) {
+        std::shared_ptr<const HullSnapshot> snapshot = currentSnapshot(g);
+        std::string frame;
+        FrameWriter writer(frame, OP_HULL);
+        writer.putF64(snapshot->hull.area);
+        writer.putPoints(snapshot->hull.points.data(), snapshot->hull.points.size(), POINTS_F64);
+        writer.finish();
+        sendAll(client_socket, frame.data(), frame.size());
+        return;
+    } else if (op != OP_NEWGRAPH && op != OP_NEWPOINTS && op != OP_REMOVEPOINTS) {
+        response << "Unknown opcode: " << (int)op << std::endl;
+    } else if (!reader.getPoints(points)) {
+        response << "Malformed point array." << std::endl;
+    } else if (op == OP_NEWGRAPH) {
+        std::lock_guard<std::mutex> lock(g.mutex);
+        loadGraph(g, points);
+        response << "New graph of " << g.graph.size << " points." << std::endl; // Not echoed: the client sent them
+    } else if (op == OP_NEWPOINTS) {
+        std::lock_guard<std::mutex> lock(g.mutex);
+        insertBatch(g, points, response);
     } else {
-       send(client_socket, out.c_str(), out.size(), 0);
+        std::lock_guard<std::mutex> lock(g.mutex);
+        deleteBatch(g, points, response);
     }
-
+    sendReply(client_socket, response.str());
 }
 
 void* on_stdin(void* fd) {
@@ -179,7 +656,7 @@ void* on_stdin(void* fd) {
     //client_sockets.insert(1); // Add the stdin socket to the set of client sockets
     while (runningServer) {
         if (std::getline(std::cin, line)) {// Read a line from stdin
-            handle_request(line, 1, graph, hull); // Handle the request from stdin
+            handle_request(line, 1); // Handle the request from stdin
             if (line == "exit") break; // If the command is "exit", break the loop
         } else {
             std::cerr << "Error or EOF on stdin." << std::endl;
@@ -189,29 +666,86 @@ void* on_stdin(void* fd) {
     return nullptr;
 }
 
+/**
+ * @brief Handle the complete frames at the start of frames and drop them, keeping a partial one.
+ * @return false if a frame length is invalid.
+ */
+static bool handleFrames(std::string& frames, int client_socket) {
+    Opcode op;
+    const char* body;
+    size_t size;
+    long used;
+    size_t done = 0; // Frames are handled in place and dropped together, not one erase each
+    while ((used = nextFrame(frames.data() + done, frames.size() - done, op, body, size)) > 0) {
+        handle_frame(op, body, size, client_socket);
+        done += used;
+    }
+    frames.erase(0, done);
+    return used == 0;
+}
+
+/**
+ * @brief Run one text line, without its line ending.
+ */
+static void handleLine(const char* line, const char* stop, int client_socket) {
+    if (stop > line && stop[-1] == '\r') stop--;
+    handle_request(std::string_view(line, stop - line), client_socket);
+}
+
+void* calibrate_hull_engines(void* tmp) {
+    calibrateHullDispatcher();
+    return nullptr;
+}
+
 void* on_client_socket(void* tmp) {
     int client_fd = (intptr_t)tmp;
     char buf[BUFSIZE];
+    std::string frames; // Received bytes of a binary connection, up to the end of the last complete frame
+    std::string partial; // Start of a text line whose '\n' has not been received yet, run as it is only at EOF
 
     client_sockets.insert(client_fd); // Add the client socket to the set of client sockets
     while (runningServer) {
         int nbytes = recv(client_fd, buf, sizeof(buf) - 1, 0);// Receive data from the client
         if (nbytes <= 0) {
             if (nbytes == 0) {
+                if (!partial.empty() && !binary_session) handleLine(partial.data(), partial.data() + partial.size(), client_fd);
                 std::cout << "Connection closed by client." << std::endl;
             } else {
                 std::cerr << "Error receiving data." << std::endl;
             }
             close(client_fd);
             break;
+        } else if (binary_session) {
+            frames.append(buf, nbytes);
         } else {
-            buf[nbytes] = '\0';
-            std::istringstream lines(buf);
-            std::string line;
-            while (std::getline(lines, line)) {// Read lines from the received data
-                if (!line.empty() && line.back() == '\r') line.pop_back();
-                handle_request(line, client_fd, graph, hull);// Handle the request from the client
+            const char* end = buf + nbytes;
+            const char* line = buf;
+            while (line < end && !binary_session) {// Split the lines in place, the commands parse them in buf
+                const char* newline = (const char*)memchr(line, '\n', end - line);
+                if (!newline) { // The rest of the line comes in a later recv
+                    partial.append(line, end - line);
+                    line = end;
+                } else if (partial.empty()) {
+                    handleLine(line, newline, client_fd);// Handle the request from the client
+                    line = newline + 1;
+                } else { // The end of a line started in an earlier recv
+                    partial.append(line, newline - line);
+                    handleLine(partial.data(), partial.data() + partial.size(), client_fd);
+                    partial.clear();
+                    line = newline + 1;
+                }
             }
+            if (binary_session) frames.assign(line, end - line); // Whatever follows the hello is already frames
+            if (partial.size() > TEXT_LINE_MAX) {
+                std::cerr << "Text line too long, closing the connection." << std::endl;
+                close(client_fd);
+                break;
+            }
+        }
+        if (binary_session && !handleFrames(frames, client_fd)) {
+            std::cerr << "Invalid frame, closing the connection." << std::endl;
+            close(client_fd);
+            break;
         }
     }
     return nullptr;
@@ -219,22 +753,22 @@ void* on_client_socket(void* tmp) {
 
 void* wait_for_CH_area_change(void * tmp){
      while (runningServer) {
-       pthread_mutex_lock(&area_mutex); // Lock the mutex to protect the area_updated flag
-        while (!area_updated) { // Wait for the area to be updated
+       pthread_mutex_lock(&area_mutex); // Lock the mutex to protect the event queue
+        while (area_events.empty() && runningServer) { // Wait for a hull area to cross the threshold
             pthread_cond_wait(&cond, &area_mutex); // Wait for the condition variable to be signaled
         }
-        if(hull.treshhold==false && hull.area >=100 ){ 
-            hull.treshhold=true;
-            std::cout << "Convex Hull Area has reached the threshold of 100. Area: " << hull.area << std::endl;
-            std::cout << "Convex Hull Points:\n";
-           
-        } else if(hull.treshhold==true && hull.area < 100){
-            hull.treshhold=false;
-            std::cout << "Convex Hull Area is below the threshold of 100. Area: " << hull.area << std::endl;
+        while (!area_events.empty()) {
+            const AreaEvent& event = area_events.front();
+            if (event.graph != DEFAULT_GRAPH) std::cout << "Graph " << event.graph << ": ";
+            if (event.above) {
+                std::cout << "Convex Hull Area has reached the threshold of 100. Area: " << event.area << std::endl;
+                std::cout << "Convex Hull Points:\n";
+            } else {
+                std::cout << "Convex Hull Area is below the threshold of 100. Area: " << event.area << std::endl;
+            }
+            area_events.pop_front();
         }
-
-          area_updated = false;
-          pthread_mutex_unlock(&area_mutex);// Unlock the mutex after processing the area update
+          pthread_mutex_unlock(&area_mutex);// Unlock the mutex after reporting the events
     }
 
   
@@ -249,7 +783,56 @@ void close_all_clients(std::set<int>& client_sockets) {
     client_sockets.clear();
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--prefilter") {
+            hull_options.prefilter = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            hull_options.threads = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--parallel-cutoff" && i + 1 < argc) {
+            hull_options.parallel_cutoff = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--engine" && i + 1 < argc && std::string(argv[i + 1]) == "monotone") {
+            hull_options.engine = ENGINE_MONOTONE;
+            ++i;
+        } else if (arg == "--engine" && i + 1 < argc && std::string(argv[i + 1]) == "quickhull") {
+            hull_options.engine = ENGINE_QUICKHULL;
+            ++i;
+        } else if (arg == "--engine" && i + 1 < argc && std::string(argv[i + 1]) == "auto") {
+            hull_options.engine = ENGINE_AUTO;
+            ++i;
+        } else if (arg == "--coords" && i + 1 < argc && std::string(argv[i + 1]) == "double") {
+            hull_options.coords = COORD_DOUBLE;
+            ++i;
+        } else if (arg == "--coords" && i + 1 < argc && std::string(argv[i + 1]) == "int32") {
+            hull_options.coords = COORD_INT32;
+            ++i;
+        } else if (arg == "--coords" && i + 1 < argc && std::string(argv[i + 1]) == "int64") {
+            hull_options.coords = COORD_INT64;
+            ++i;
+        } else if (arg == "--scale" && i + 1 < argc && std::isfinite(atof(argv[i + 1])) && atof(argv[i + 1]) > 0) {
+            hull_options.scale = atof(argv[++i]);
+        } else if (arg == "--match-epsilon" && i + 1 < argc && std::isfinite(atof(argv[i + 1])) && atof(argv[i + 1]) >= 0) {
+            hull_options.match_epsilon = atof(argv[++i]);
+        } else if (arg == "--window" && i + 1 < argc && atol(argv[i + 1]) > 0) {
+            hull_options.window_points = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--window-seconds" && i + 1 < argc && std::isfinite(atof(argv[i + 1])) && atof(argv[i + 1]) > 0) {
+            hull_options.window_seconds = atof(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--prefilter] [--threads N] [--parallel-cutoff N]"
+                      << " [--engine monotone|quickhull|auto] [--coords double|int32|int64] [--scale S]"
+                      << " [--window N] [--window-seconds T] [--match-epsilon E]" << std::endl;
+            return 1;
+        }
+    }
+    if (hull_options.coords != COORD_DOUBLE && (hull_options.window_points > 0 || hull_options.window_seconds > 0)) {
+        std::cerr << "The window modes keep double coordinates, they can't be used with --coords int32|int64." << std::endl;
+        return 1;
+    }
+    std::unique_ptr<ThreadPool> pool; // Threads for the parallel hull engines, the calling thread helps too
+    if (hull_options.threads > 1) pool.reset(new ThreadPool(hull_options.threads - 1));
+    setHullThreadPool(pool.get());
+
     int sk = socket(AF_INET, SOCK_STREAM, 0);// Create a socket
     if (sk < 0) {
         std::cerr << "Error creating socket." << std::endl;
@@ -273,19 +856,22 @@ int main() {
         return 1;
     }
 
-    hull.treshhold=false;
     Proactor proactor;// Create a Proactor instance
 
     pthread_t cond_var_t;
     pthread_create(&cond_var_t, nullptr, wait_for_CH_area_change, nullptr);
 
+    pthread_t calibration_thread; // Times the engines while the server already answers with the default thresholds
+    bool calibrating = hull_options.engine == ENGINE_AUTO;
+    if (calibrating) pthread_create(&calibration_thread, nullptr, calibrate_hull_engines, nullptr);
+
     pthread_t server_thread = proactor.startProactor(sk, on_client_socket);// Start the Proactor with the server socket and the client handler function
     pthread_t stdin_thread;// Create a thread for handling stdin input
     pthread_create(&stdin_thread, nullptr, on_stdin, nullptr);// Start the stdin thread
 
     std::cout << "Server started on port " << PORT << std::endl;
     std::cout << "Convex Hull Algorithm Implementation" << std::endl;
-    std::cout << "Available commands: Newgraph, CH, Newpoint, Removepoint , exit" << std::endl;
+    std::cout << "Available commands: Use, Newgraph, CH, Contains, ContainsBatch, Diameter, Width, MinRect, Perimeter, Newpoint, Newpoints, Removepoint, Removepoints, Binary, exit" << std::endl;
 
     while (runningServer) {// Main loop to keep the server running
         sleep(1);
@@ -298,6 +884,7 @@ int main() {
     proactor.stopProactor(server_thread);// Stop the Proactor and wait for the server thread to finish
     pthread_join(stdin_thread, nullptr);// Wait for the stdin thread to finish
     pthread_join(server_thread, nullptr);// Wait for the server thread to finish
+    if (calibrating) pthread_join(calibration_thread, nullptr);// It uses the pool, which goes away with main
    
     
     
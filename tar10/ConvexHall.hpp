@@ -1,7 +1,12 @@
 #ifndef CONVEXHALL_HPP
 #define CONVEXHALL_HPP
+#include <iostream>
+#include <sstream>
 #include <vector>
 #include <set>
+#include <string>
+#include <string_view>
+#include <memory>
 typedef struct Point{
     double x;
     double y;
@@ -16,8 +21,38 @@ typedef struct ConvexHull{
     int size;
     double area;
     bool treshhold;
+    unsigned long version; // For the graph, bumped by every change; for the hull, by every change that can move it
 } ConvexHull;
 
+typedef enum HullEngine{
+    ENGINE_MONOTONE,  // Andrew's monotone chain (or its parallel version above the cutoff)
+    ENGINE_QUICKHULL, // QuickHull, with tasks on the thread pool above the cutoff
+    ENGINE_AUTO       // Picked per call by the dispatcher, from thresholds calibrated at startup
+} HullEngine;
+
+typedef enum CoordMode{
+    COORD_DOUBLE, // Points are kept as they are parsed
+    COORD_INT32,  // Fixed point, |x * scale| and |y * scale| below 2^30
+    COORD_INT64   // Fixed point, |x * scale| and |y * scale| below 2^62
+} CoordMode;
+
+/**
+ * @brief Switches for the full hull computation, set from the command line.
+ */
+typedef struct HullOptions{
+    HullEngine engine = ENGINE_AUTO; // --engine monotone|quickhull|auto
+    bool prefilter = false;          // Run the Akl-Toussaint filter before the chain (--prefilter)
+    int threads = 1;                 // Worker threads for large inputs (--threads N)
+    size_t parallel_cutoff = 200000; // Fewer points than this always use the serial path (--parallel-cutoff N)
+    CoordMode coords = COORD_DOUBLE; // Storage of the graph points (--coords double|int32|int64)
+    double scale = 1000.0;           // Fixed point units per coordinate unit (--scale S)
+    size_t window_points = 0;        // Keep only the last N points, 0 for all (--window N)
+    double window_seconds = 0;       // Keep only the points of the last T seconds, 0 for all (--window-seconds T)
+    double match_epsilon = 0;        // Newpoint/Removepoint match points in the same cell of this size, 0 for exact (--match-epsilon E)
+} HullOptions;
+
+extern HullOptions hull_options;
+
 /**
  * @brief Print the points of the convex hull.
  * @param hull The convex hull containing the points.
@@ -27,10 +62,24 @@ void printConvexHull(const ConvexHull& hull, std::ostream& os = std::cout);
 
 /**
  * @brief Calculate the convex hull of a set of points.
+ * The serial path works in the calling thread's HullArena, so it doesn't copy or
+ * allocate once the arena has grown to the size of the input.
  * @param points The input points to form the convex hull.
  * @param hull The ConvexHull structure to store the result.
  */
-void convexHull(std::vector<Point> points, ConvexHull& hull);
+void convexHull(const std::vector<Point>& points, ConvexHull& hull);
+
+struct PointSpan;
+
+/**
+ * @brief Calculate the convex hull of points that are already sorted, given as runs (see SortedPoints::spans).
+ * The dispatcher picks between the linear chain over the runs and its parallel version;
+ * --engine quickhull and --prefilter apply here too.
+ * @param spans The sorted runs.
+ * @param count The number of runs.
+ * @param hull The ConvexHull structure to store the result.
+ */
+void convexHull(const PointSpan* spans, size_t count, ConvexHull& hull);
 
 /**
  * @brief Calculate the cross product of three points.
@@ -48,37 +97,60 @@ double cross(const Point& p1, const Point& p2, const Point& p3);
  */
 double polygonArea(const std::vector<Point>& poly);
 
+struct GraphState;
+class CommandParser;
+
 /**
- * @brief Read points from an input stream and populate the ConvexHull structure.
- * @param graph The ConvexHull structure to populate.
+ * @brief Read points from a command line and replace the points of a graph with them.
+ * @param g The graph to populate.
  * @param n The number of points to read.
- * @param iss The input stream containing the points.
+ * @param parser The command line, at the points.
+ * @return false if n is negative or the line has fewer than n valid points; the graph is then unchanged.
  */
-void readPoints(ConvexHull& graph, int n,std::istringstream& iss);
+bool readPoints(GraphState& g, int n, CommandParser& parser);
 
 /**
- * @brief Add a new point to the ConvexHull structure and print the updated convex hull.
- * @param graph The ConvexHull structure to update.
- * @param iss The input stream containing the new point.
+ * @brief Add a new point to a graph and print the updated graph.
+ * @param g The graph to update.
+ * @param parser The command line, at the new point.
+ * @param os The output stream to report a duplicate point to.
  */
-void addPoint(ConvexHull& graph, std::istringstream& iss);
+void addPoint(GraphState& g, CommandParser& parser, std::ostream& os = std::cout);
 
 /**
- * @brief Remove a point from the ConvexHull structure and print the updated convex hull.
- * @param graph The ConvexHull structure to update.
- * @param iss The input stream containing the point to remove.
+ * @brief Remove one copy of a point from a graph and print the updated graph.
+ * @param g The graph to update.
+ * @param parser The command line, at the point to remove.
  * @param os The output stream to print the result.
  */
-void removePoint(ConvexHull& graph, std::istringstream& iss, std::ostream& os = std::cout);
+void removePoint(GraphState& g, CommandParser& parser, std::ostream& os = std::cout);
+
+/**
+ * @brief Add a batch of points ("n x1,y1 ...") to a graph, with one version bump for the whole batch.
+ * An invalid list is reported on os and changes nothing.
+ * @param g The graph to update.
+ * @param parser The command line, at the count and the points.
+ * @param os The output stream to print a one line summary to.
+ */
+void addPoints(GraphState& g, CommandParser& parser, std::ostream& os);
+
+/**
+ * @brief Remove one copy of each point of a batch ("n x1,y1 ...") from a graph, with one version bump.
+ * An invalid list is reported on os and changes nothing.
+ * @param g The graph to update.
+ * @param parser The command line, at the count and the points.
+ * @param os The output stream to print a one line summary to.
+ */
+void removePoints(GraphState& g, CommandParser& parser, std::ostream& os);
 
 /**
  * @brief Handle a request from a client or stdin.
- * @param request The request string.
+ * Commands run on the graph the connection selected with Use (DEFAULT_GRAPH until then),
+ * under that graph's lock only.
+ * @param request The request line, read in place (it can point into a receive buffer).
  * @param client_socket The socket descriptor for the client (1 for stdin).
- * @param graph The ConvexHull structure to operate on.
- * @param hull The ConvexHull structure to store the convex hull result.
  */
-void handle_request(const std::string& request, int client_socket);
+void handle_request(std::string_view request, int client_socket);
 
 /**
  * @brief Thread function to handle stdin input.
@@ -100,6 +172,13 @@ void* on_client_socket(int client_fd);
  */
 void* wait_for_CH_area_change(void * tmp);
 
+/**
+ * @brief Thread function that calibrates the hull dispatcher once at startup (with --engine auto).
+ * @param tmp Pointer to temporary data (not used).
+ * @return A pointer to the result (nullptr).
+ */
+void* calibrate_hull_engines(void* tmp);
+
 /**
  * @brief Close all client sockets and clear the set of client sockets.
  * @param client_sockets The set of client socket file descriptors to close.
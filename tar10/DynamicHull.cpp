@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <iterator>
+#include "DynamicHull.hpp"
+#include "HullEngines.hpp"
+#include "Predicates.hpp"
+
+DynamicHull::DynamicHull():valid(false){
+}
+
+void DynamicHull::invalidate() {
+    lower.clear();
+    upper.clear();
+    valid = false;
+}
+
+void DynamicHull::rebuild(const SortedPoints& points) {
+    ConvexHull tmp;
+    std::vector<PointSpan> spans;
+    points.spans(spans);
+    convexHull(spans.data(), spans.size(), tmp); // The graph is sorted, so no engine sorts again; starts at the leftmost point and goes counter clockwise
+    lower.clear();
+    upper.clear();
+    valid = true;
+    if (points.empty()) return;
+    if (tmp.points.empty()) { // A single point has no hull, but it still bounds the next insertions
+        lower.insert(points.front());
+        upper.insert(points.front());
+        return;
+    }
+    size_t right = 0; // Index of the rightmost point, where the lower chain ends
+    for (size_t i = 1; i < tmp.points.size(); ++i) {
+        if (tmp.points[right] < tmp.points[i]) right = i;
+    }
+    lower.insert(tmp.points.begin(), tmp.points.begin() + right + 1);
+    upper.insert(tmp.points.begin() + right, tmp.points.end());
+    upper.insert(tmp.points[0]);
+}
+
+bool DynamicHull::coveredByChain(const std::set<Point>& chain, const Point& p, int sign) {
+    auto next = chain.lower_bound(p);
+    if (next != chain.end() && !(p < *next)) return true; // Already a vertex
+    if (next == chain.begin() || next == chain.end()) return false; // Beyond an end of the chain
+    return sign * orient(*std::prev(next), *next, p) >= 0; // On or inside the edge above/below p
+}
+
+void DynamicHull::insertIntoChain(std::set<Point>& chain, const Point& p, int sign) {
+    auto it = chain.insert(p).first;
+    while (it != chain.begin()) { // Drop the vertices on the left that are no longer convex
+        auto b = std::prev(it);
+        if (b == chain.begin()) break;
+        auto a = std::prev(b);
+        if (sign * orient(*a, *b, p) > 0) break;
+        chain.erase(b);
+    }
+    while (true) { // Same on the right
+        auto b = std::next(it);
+        if (b == chain.end()) break;
+        auto c = std::next(b);
+        if (c == chain.end()) break;
+        if (sign * orient(p, *b, *c) > 0) break;
+        chain.erase(b);
+    }
+}
+
+bool DynamicHull::insert(const Point& p) {
+    if (!valid) return true; // Picked up by the next rebuild
+    bool inLower = coveredByChain(lower, p, 1);
+    bool inUpper = coveredByChain(upper, p, -1);
+    if (inLower && inUpper) return false; // Interior point, the common case of a long stream
+    if (!inLower) insertIntoChain(lower, p, 1);
+    if (!inUpper) insertIntoChain(upper, p, -1);
+    return true;
+}
+
+void DynamicHull::repairChain(std::set<Point>& chain, std::set<Point>::iterator it,
+                              const SortedPoints& points, int sign) {
+    Point a = *std::prev(it);
+    Point b = *std::next(it);
+    chain.erase(it);
+
+    std::vector<Point> under; // Points that were hidden behind the removed vertex
+    points.forRange(a, b, [&](const Point& q) { // Already in order
+        if (sign * orient(a, b, q) < 0) under.push_back(q);
+    });
+    if (under.empty()) return;
+    under.push_back(b);
+
+    std::vector<Point> stack;
+    stack.push_back(a);
+    for (const Point& q : under) { // Monotone chain between a and b only
+        while (stack.size() >= 2 && sign * orient(stack[stack.size()-2], stack.back(), q) <= 0) stack.pop_back();
+        stack.push_back(q);
+    }
+    chain.insert(stack.begin() + 1, stack.end() - 1);
+}
+
+bool DynamicHull::erase(const Point& p, const SortedPoints& points) {
+    if (!valid) return true;
+    auto lo = lower.find(p);
+    auto up = upper.find(p);
+    if (lo == lower.end() && up == upper.end()) return false; // Not a hull vertex, nothing changes
+
+    bool lowEnd = lo != lower.end() && (lo == lower.begin() || std::next(lo) == lower.end());
+    bool upEnd = up != upper.end() && (up == upper.begin() || std::next(up) == upper.end());
+    if (lowEnd || upEnd) { // The leftmost or rightmost point changes both chains
+        rebuild(points);
+        return true;
+    }
+    if (lo != lower.end()) repairChain(lower, lo, points, 1);
+    if (up != upper.end()) repairChain(upper, up, points, -1);
+    return true;
+}
+
+void DynamicHull::toHull(ConvexHull& hull) const {
+    hull.points.clear();
+    if (lower.size() < 2) {
+        hull.size = 0;
+        return;
+    }
+    hull.points.assign(lower.begin(), lower.end());
+    for (auto it = std::next(upper.rbegin()); it != std::prev(upper.rend()); ++it) {
+        hull.points.push_back(*it);
+    }
+    hull.size = hull.points.size();
+}
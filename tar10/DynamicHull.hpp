@@ -0,0 +1,74 @@
+#ifndef DYNAMICHULL_HPP
+#define DYNAMICHULL_HPP
+#include <set>
+#include <vector>
+#include "ConvexHall.hpp"
+#include "SortedPoints.hpp"
+
+/**
+ * @brief Convex hull kept up to date across Newpoint/Removepoint.
+ *
+ * The hull is stored as its lower and upper monotone chains, each ordered by
+ * Point::operator<. Both chains share the leftmost and the rightmost point.
+ * Inserting a point touches only the chains: an interior point is rejected
+ * after one O(log h) lookup per chain, an outside point is spliced in and the
+ * vertices it hides are dropped (O(log h) each). Removing a hull vertex reads the graph points between its two
+ * neighbours (a range of the sorted graph) and chains the ones under the edge.
+ */
+class DynamicHull {
+    private:
+        std::set<Point> lower; // Left turns, from the leftmost to the rightmost point
+        std::set<Point> upper; // Right turns, from the leftmost to the rightmost point
+        bool valid;            // False until the chains are built from the graph
+
+        // Whether p is a vertex of a chain or on its inner side; sign is 1 for the lower chain and -1 for the upper one.
+        static bool coveredByChain(const std::set<Point>& chain, const Point& p, int sign);
+        // Inserts p (not covered by the chain) and drops the vertices that are no longer convex.
+        static void insertIntoChain(std::set<Point>& chain, const Point& p, int sign);
+        // Replaces the inner vertex p of a chain by the chain of the points under it.
+        static void repairChain(std::set<Point>& chain, std::set<Point>::iterator it,
+                                const SortedPoints& points, int sign);
+
+    public:
+        DynamicHull();
+
+        /**
+         * @brief Drop the chains. The next call to rebuild() builds them again.
+         */
+        void invalidate();
+
+        /**
+         * @brief Check whether the chains match the graph.
+         * @return true if the chains were built and kept up to date.
+         */
+        bool isValid() const { return valid; }
+
+        /**
+         * @brief Build both chains from scratch.
+         * @param points All the points of the graph.
+         */
+        void rebuild(const SortedPoints& points);
+
+        /**
+         * @brief Add a point to the hull.
+         * @param p The new point.
+         * @return true if the hull changed (always true while the chains are not built).
+         */
+        bool insert(const Point& p);
+
+        /**
+         * @brief Remove a point from the hull.
+         * @param p The removed point.
+         * @param points The points of the graph after p was removed.
+         * @return true if the hull changed (always true while the chains are not built).
+         */
+        bool erase(const Point& p, const SortedPoints& points);
+
+        /**
+         * @brief Write the hull in the same order as convexHull() does.
+         * @param hull The ConvexHull structure to store the result.
+         */
+        void toHull(ConvexHull& hull) const;
+};
+
+#endif
@@ -0,0 +1,15 @@
+#include "GraphRegistry.hpp"
+
+std::shared_ptr<GraphState> GraphRegistry::get(const std::string& name) {
+    Shard& shard = shards[std::hash<std::string>()(name) % GRAPH_SHARDS];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::shared_ptr<GraphState>& state = shard.graphs[name];
+    if (!state) {
+        state = std::make_shared<GraphState>();
+        state->name = name;
+        state->quantized_graph.reset(hull_options.coords, hull_options.scale);
+        state->point_index.reset(hull_options.match_epsilon);
+        state->window_graph.reset(hull_options.window_points, hull_options.window_seconds);
+    }
+    return state;
+}
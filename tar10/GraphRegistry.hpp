@@ -0,0 +1,80 @@
+#ifndef GRAPHREGISTRY_HPP
+#define GRAPHREGISTRY_HPP
+#include <mutex>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "ConvexHall.hpp"
+#include "DynamicHull.hpp"
+#include "SortedPoints.hpp"
+#include "QuantizedPoints.hpp"
+#include "SlidingHull.hpp"
+#include "HullQueries.hpp"
+#include "PointIndex.hpp"
+
+#define GRAPH_SHARDS 16        // Independently locked parts of the registry
+#define DEFAULT_GRAPH "default" // Graph of a connection until it sends Use
+
+/**
+ * @brief The hull of one version of a graph and the answers built from it.
+ * Never changed once published, so readers use it without any lock; the last
+ * reader holding an old snapshot frees it.
+ */
+typedef struct HullSnapshot{
+    unsigned long version;    // hull.version it was built for
+    ConvexHull hull;
+    std::string response;     // The CH response
+
+    /**
+     * @brief The rotating calipers measures, computed by the first caller.
+     */
+    const HullMetrics& metrics() const {
+        std::call_once(metrics_once, [this]() { hullMetrics(hull.points, metrics_value); });
+        return metrics_value;
+    }
+
+    private:
+        mutable std::once_flag metrics_once;
+        mutable HullMetrics metrics_value;
+} HullSnapshot;
+
+/**
+ * @brief One named graph and everything derived from it, guarded by its own mutex.
+ */
+typedef struct GraphState{
+    std::string name;
+    std::mutex mutex;               // Held by the writers, which also publish the snapshot
+    ConvexHull graph;
+    ConvexHull hull;
+    DynamicHull dynamic_hull;       // Hull of graph, updated by Newpoint/Removepoint
+    std::shared_ptr<const HullSnapshot> snapshot; // Last published hull, only read and replaced with std::atomic_load/atomic_store
+    SortedPoints graph_points;      // The graph points, in sorted order; graph.points stays empty
+    PointIndex point_index;         // Copies of each point of graph_points, by coordinates
+    QuantizedPoints quantized_graph; // The graph points with --coords int32|int64 instead of graph_points
+    SlidingHull window_graph;       // The graph points with --window N or --window-seconds T instead of graph_points
+} GraphState;
+
+/**
+ * @brief The named graphs of the server.
+ *
+ * The names are spread over GRAPH_SHARDS maps by hash, each with its own mutex,
+ * which is only held for the lookup: commands on a graph lock the graph itself,
+ * so a long CH on one graph doesn't stall the others.
+ */
+class GraphRegistry {
+    private:
+        typedef struct Shard{
+            std::mutex mutex;
+            std::unordered_map<std::string, std::shared_ptr<GraphState>> graphs;
+        } Shard;
+
+        Shard shards[GRAPH_SHARDS];
+
+    public:
+        /**
+         * @brief The graph with this name, created empty (with the command line storage options) on first use.
+         */
+        std::shared_ptr<GraphState> get(const std::string& name);
+};
+
+#endif
@@ -0,0 +1,24 @@
+#include "HullArena.hpp"
+#include "HullEngines.hpp"
+
+HullArena& HullArena::local() {
+    static thread_local HullArena arena;
+    return arena;
+}
+
+std::vector<Point>& HullArena::load(const std::vector<Point>& points) {
+    work.assign(points.begin(), points.end());
+    return work;
+}
+
+void HullArena::hull(ConvexHull& hull) {
+    size_t n = work.size();
+    Point* buffer = nullptr;
+    if (n <= ARENA_RADIX_MAX_POINTS) {
+        if (scratch.size() < n) scratch.resize(n);
+        buffer = scratch.data();
+    }
+    size_t h = convexHullInPlace(work.data(), n, buffer);
+    hull.points.assign(work.begin(), work.begin() + h);
+    hull.size = h;
+}
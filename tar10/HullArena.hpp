@@ -0,0 +1,40 @@
+#ifndef HULLARENA_HPP
+#define HULLARENA_HPP
+#include <vector>
+#include <cstddef>
+#include "ConvexHall.hpp"
+
+#define ARENA_RADIX_MAX_POINTS (1 << 24) // Above this the arena sorts in place instead of keeping a radix buffer
+
+/**
+ * @brief Working memory for the hull computations of one thread, reused across calls.
+ *
+ * The buffers only grow, so once a thread has computed a hull of n points, the next
+ * hulls of up to n points don't allocate. Graphs above ARENA_RADIX_MAX_POINTS are
+ * sorted in place, so their peak is one working copy of the points on top of the graph.
+ */
+class HullArena {
+    private:
+        std::vector<Point> work;    // The copy of the input the hull is computed in
+        std::vector<Point> scratch; // Second buffer of the radix sort
+
+    public:
+        /**
+         * @brief The arena of the calling thread.
+         */
+        static HullArena& local();
+
+        /**
+         * @brief Copy points into the working buffer, reusing its capacity.
+         * @return The buffer, for the filters that run before the hull.
+         */
+        std::vector<Point>& load(const std::vector<Point>& points);
+
+        /**
+         * @brief Run convexHullInPlace over the working buffer.
+         * @param hull Receives the hull; its capacity is reused too.
+         */
+        void hull(ConvexHull& hull);
+};
+
+#endif
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <limits>
+#include <atomic>
+#include <iostream>
+#include "HullDispatcher.hpp"
+#include "HullEngines.hpp"
+#include "HullArena.hpp"
+
+#define CALIBRATION_MIN (1 << 11) // Smallest input timed by the calibration
+#define CALIBRATION_MAX (1 << 17) // Largest input timed, the sizes grow 4x at a time
+#define CALIBRATION_RUNS 2        // Best of this many runs per engine and size
+
+static const size_t NEVER = std::numeric_limits<size_t>::max();
+
+static DispatchThresholds default_thresholds = {NEVER, 200000, 200000}; // Until the calibration publishes: no QuickHull, parallel at the default cutoff
+static DispatchThresholds calibrated_thresholds; // Written once by the calibration, before it is published
+static std::atomic<const DispatchThresholds*> thresholds(&default_thresholds);
+
+/**
+ * @brief Best wall clock time of fn over CALIBRATION_RUNS runs, in seconds.
+ */
+template <typename Fn>
+static double bestTime(Fn fn) {
+    double best = std::numeric_limits<double>::max();
+    for (int run = 0; run < CALIBRATION_RUNS; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+/**
+ * @brief Record one calibration size: the threshold is the first size of the run of sizes the engine won.
+ */
+static void crossover(size_t& threshold, size_t n, bool won) {
+    if (!won) {
+        threshold = NEVER;
+    } else if (threshold == NEVER) {
+        threshold = n;
+    }
+}
+
+/**
+ * @brief CALIBRATION_MAX random points, the same on every host.
+ */
+static std::vector<Point> calibrationPoints() {
+    std::mt19937_64 rng(12345);
+    std::uniform_real_distribution<double> coord(-1000.0, 1000.0);
+    std::vector<Point> points(CALIBRATION_MAX);
+    for (Point& p : points) p = Point{coord(rng), coord(rng)};
+    return points;
+}
+
+static void printThreshold(const char* engine, size_t threshold) {
+    std::cout << engine;
+    if (threshold == NEVER) std::cout << " never"; else std::cout << " from " << threshold << " points";
+}
+
+/**
+ * @brief Time the engines for unsorted input against the serial chain in the arena.
+ */
+static void calibrateUnsorted(DispatchThresholds& found) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Point> points = calibrationPoints();
+    bool threads = hull_options.threads > 1;
+    size_t quickhull_min = NEVER, parallel_min = NEVER;
+    ConvexHull hull;
+    for (size_t n = CALIBRATION_MIN; n <= CALIBRATION_MAX; n *= 4) {
+        std::vector<Point> input(points.begin(), points.begin() + n);
+        double serial = bestTime([&]() {
+            HullArena& arena = HullArena::local();
+            arena.load(input);
+            arena.hull(hull);
+        });
+        double quick = bestTime([&]() { convexHull_QuickHull(input, hull); });
+        crossover(quickhull_min, n, quick < serial);
+        if (threads) {
+            double parallel = bestTime([&]() { convexHullParallel(input, hull, hull_options.threads); });
+            crossover(parallel_min, n, parallel < serial);
+        }
+    }
+    if (parallel_min == NEVER && threads) {
+        parallel_min = (size_t)CALIBRATION_MAX * 4; // Still slower at the largest size, the crossover is further up
+    }
+    found.quickhull_min = quickhull_min;
+    found.parallel_min = parallel_min;
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Hull engine calibration took " << elapsed.count() << " ms:";
+    printThreshold(" QuickHull for small hulls", quickhull_min);
+    if (threads) printThreshold(", parallel", parallel_min);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Time the parallel chain over sorted runs against the serial one.
+ */
+static void calibrateSorted(DispatchThresholds& found) {
+    auto start = std::chrono::steady_clock::now();
+    std::mt19937_64 rng(12345);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    size_t parallel_min = NEVER;
+    ConvexHull hull;
+    for (size_t n = CALIBRATION_MIN; n <= CALIBRATION_MAX; n *= 4) {
+        std::vector<Point> input(n); // Random points in the same square, made sorted by drawing x in increasing strata
+        for (size_t i = 0; i < n; ++i) input[i] = Point{-1000.0 + 2000.0 * (i + unit(rng)) / n, -1000.0 + 2000.0 * unit(rng)};
+        PointSpan runs = {input.data(), input.size()};
+        double chain = bestTime([&]() { monotoneChain(&runs, 1, hull); });
+        double split = bestTime([&]() { convexHullParallel(&runs, 1, hull, hull_options.threads); });
+        crossover(parallel_min, n, split < chain);
+    }
+    if (parallel_min == NEVER) parallel_min = (size_t)CALIBRATION_MAX * 4;
+    found.presorted_parallel_min = parallel_min;
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Hull engine calibration for sorted input took " << elapsed.count() << " ms:";
+    printThreshold(" parallel chain", parallel_min);
+    std::cout << std::endl;
+}
+
+void calibrateHullDispatcher() {
+    DispatchThresholds found = default_thresholds;
+    calibrateUnsorted(found);
+    if (hull_options.threads > 1 && hullThreadPool()) calibrateSorted(found); // Without threads the sorted choice is always the chain
+    calibrated_thresholds = found;
+    thresholds.store(&calibrated_thresholds, std::memory_order_release);
+}
+
+/**
+ * @brief Whether the points are sorted by Point::operator<.
+ * A few evenly spaced pairs reject most unsorted inputs before the full scan.
+ */
+static bool isPresorted(const std::vector<Point>& points) {
+    size_t n = points.size();
+    if (n < 2) return true;
+    for (size_t j = 0; j < DISPATCH_ORDER_PROBES; ++j) {
+        size_t i = (n - 1) * j / DISPATCH_ORDER_PROBES;
+        if (points[i + 1] < points[i]) return false;
+    }
+    return std::is_sorted(points.begin(), points.end());
+}
+
+/**
+ * @brief Whether a strided sample of the points has few of them on its hull.
+ */
+static bool smallHull(const std::vector<Point>& points) {
+    size_t n = points.size();
+    size_t m = std::min<size_t>(n, DISPATCH_SAMPLE);
+    Point sample[DISPATCH_SAMPLE];
+    for (size_t j = 0; j < m; ++j) sample[j] = points[n * j / m];
+    size_t h = convexHullInPlace(sample, m, nullptr);
+    return h < DISPATCH_SMALL_HULL * m;
+}
+
+HullChoice chooseHullEngine(const std::vector<Point>& points) {
+    size_t n = points.size();
+    if (isPresorted(points)) return CHOICE_PRESORTED;
+    if (n < CALIBRATION_MIN) return CHOICE_SERIAL; // Below any threshold the calibration can set
+    const DispatchThresholds& t = *thresholds.load(std::memory_order_acquire);
+    if (n >= t.quickhull_min && smallHull(points)) return CHOICE_QUICKHULL;
+    if (hull_options.threads > 1 && n >= t.parallel_min) return CHOICE_PARALLEL;
+    return CHOICE_SERIAL;
+}
+
+HullChoice chooseSortedHullEngine(size_t n) {
+    if (hull_options.engine == ENGINE_QUICKHULL) return CHOICE_QUICKHULL;
+    if (hull_options.threads < 2 || !hullThreadPool()) return CHOICE_PRESORTED;
+    if (hull_options.engine != ENGINE_AUTO) return n >= hull_options.parallel_cutoff ? CHOICE_PARALLEL : CHOICE_PRESORTED;
+    return n >= thresholds.load(std::memory_order_acquire)->presorted_parallel_min ? CHOICE_PARALLEL : CHOICE_PRESORTED;
+}
@@ -0,0 +1,57 @@
+#ifndef HULLDISPATCHER_HPP
+#define HULLDISPATCHER_HPP
+#include <vector>
+#include <cstddef>
+#include "ConvexHall.hpp"
+
+#define DISPATCH_SAMPLE 1024         // Points in the sample whose hull estimates the hull size
+#define DISPATCH_ORDER_PROBES 64     // Adjacent pairs checked before scanning for presorted input
+#define DISPATCH_SMALL_HULL 0.1      // Sample hull / sample size below this counts as a small hull
+
+/**
+ * @brief The ways convexHull() can compute one hull.
+ */
+typedef enum HullChoice{
+    CHOICE_PRESORTED, // Input already sorted: monotone chain over it, no copy and no sort
+    CHOICE_SERIAL,    // In place monotone chain in the thread's arena
+    CHOICE_PARALLEL,  // Divide and conquer on several threads
+    CHOICE_QUICKHULL  // QuickHull, fastest when few points are on the hull
+} HullChoice;
+
+/**
+ * @brief Input sizes from which the engines beat the serial monotone chain on this host.
+ * They are timed on random inputs by calibrateHullDispatcher(), which main runs on its own
+ * thread at startup. Until it publishes them, the choices use fixed defaults.
+ */
+typedef struct DispatchThresholds{
+    size_t quickhull_min;          // QuickHull for small hulls from this many points
+    size_t parallel_min;           // Parallel divide and conquer from this many points (with --threads > 1)
+    size_t presorted_parallel_min; // Parallel chain over sorted runs from this many points (with --threads > 1)
+} DispatchThresholds;
+
+/**
+ * @brief Time the engines and publish the thresholds the choices use from then on.
+ * Blocks for a few hundred milliseconds. Call it once, after the hull thread pool is set,
+ * and never from a request: the timings are only meaningful on an idle host.
+ */
+void calibrateHullDispatcher();
+
+/**
+ * @brief Pick the engine for one input.
+ * Looks at the size, whether the points are already sorted (a few sampled pairs, then
+ * a full scan only if they all are), and the hull size of a strided sample.
+ * @param points The input points.
+ * @return The engine to use.
+ */
+HullChoice chooseHullEngine(const std::vector<Point>& points);
+
+/**
+ * @brief Pick the engine for input that is already sorted, like the graph points.
+ * The serial chain is linear then, so the only choices are the chain (CHOICE_PRESORTED),
+ * the parallel chain over the runs (CHOICE_PARALLEL), or QuickHull when --engine asks for it.
+ * @param n The number of points.
+ * @return The engine to use.
+ */
+HullChoice chooseSortedHullEngine(size_t n);
+
+#endif
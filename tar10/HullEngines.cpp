@@ -0,0 +1,493 @@
+#include <algorithm>
+#include "HullEngines.hpp"
+#include "PointsSoA.hpp"
+#include "RadixSort.hpp"
+#include "ThreadPool.hpp"
+#include "Predicates.hpp"
+#include "ParallelSort.hpp"
+
+#define ORIENT_BLOCK 256 // Points per batch of orientation tests in monotoneChain
+#define QUICKHULL_GRAIN 16384 // Smaller QuickHull subproblems are not split into tasks
+
+static ThreadPool* hull_pool = nullptr;
+
+/**
+ * @brief The polygon of the extreme points in 8 directions (x, y, x+y, x-y), counter clockwise from the bottom.
+ * @return The number of distinct corners; below 3 the input is flat and nothing is strictly inside.
+ */
+static int extremePolygon(const PointSpan* spans, size_t count, Point poly[8]) {
+    Point ext[8];
+    bool found = false;
+    for (size_t s = 0; s < count; ++s) {
+        for (size_t i = 0; i < spans[s].size; ++i) {
+            const Point& p = spans[s].data[i];
+            if (!found) {
+                for (Point& e : ext) e = p;
+                found = true;
+                continue;
+            }
+            if (p.y < ext[0].y) ext[0] = p;                        // min y
+            if (p.x - p.y > ext[1].x - ext[1].y) ext[1] = p;       // max x-y
+            if (p.x > ext[2].x) ext[2] = p;                        // max x
+            if (p.x + p.y > ext[3].x + ext[3].y) ext[3] = p;       // max x+y
+            if (p.y > ext[4].y) ext[4] = p;                        // max y
+            if (p.x - p.y < ext[5].x - ext[5].y) ext[5] = p;       // min x-y
+            if (p.x < ext[6].x) ext[6] = p;                        // min x
+            if (p.x + p.y < ext[7].x + ext[7].y) ext[7] = p;       // min x+y
+        }
+    }
+    if (!found) return 0;
+    int m = 0;
+    for (int i = 0; i < 8; ++i) { // Skip repeated corners, the same point can be extreme in several directions
+        const Point& p = ext[i];
+        if (m > 0 && p.x == poly[m-1].x && p.y == poly[m-1].y) continue;
+        poly[m++] = p;
+    }
+    if (m > 1 && poly[0].x == poly[m-1].x && poly[0].y == poly[m-1].y) m--;
+    return m;
+}
+
+static bool strictlyInside(const Point* poly, int m, const Point& p) {
+    for (int i = 0; i < m; ++i) {
+        if (orient(poly[i], poly[(i + 1) % m], p) <= 0) return false;
+    }
+    return true;
+}
+
+size_t aklToussaintFilter(std::vector<Point>& points) {
+    if (points.size() < 8) return 0;
+    PointSpan all = {points.data(), points.size()};
+    Point poly[8];
+    int m = extremePolygon(&all, 1, poly);
+    if (m < 3) return 0; // Flat input, nothing is strictly inside
+    auto end = std::partition(points.begin(), points.end(), [&](const Point& p) { return !strictlyInside(poly, m, p); });
+    return points.end() - end;
+}
+
+size_t aklToussaintFilter(const PointSpan* spans, size_t count, std::vector<Point>& kept) {
+    kept.clear();
+    Point poly[8];
+    int m = extremePolygon(spans, count, poly);
+    for (size_t s = 0; s < count; ++s) {
+        for (size_t i = 0; i < spans[s].size; ++i) {
+            const Point& p = spans[s].data[i];
+            if (m < 3 || !strictlyInside(poly, m, p)) kept.push_back(p);
+        }
+    }
+    size_t n = 0;
+    for (size_t s = 0; s < count; ++s) n += spans[s].size;
+    return n - kept.size();
+}
+
+void monotoneChain(const PointSpan* spans, size_t count, ConvexHull& hull) {
+    std::vector<Point>& stack = hull.points;
+    stack.clear();
+    size_t n = 0, firstSpan = count, lastSpan = 0;
+    for (size_t s = 0; s < count; ++s) {
+        if (spans[s].size == 0) continue;
+        if (firstSpan == count) firstSpan = s;
+        lastSpan = s;
+        n += spans[s].size;
+    }
+    if (n == 0) {
+        hull.size = 0;
+        return;
+    }
+    double side[ORIENT_BLOCK];
+    const Point first = spans[firstSpan].data[0];
+    const Point last = spans[lastSpan].data[spans[lastSpan].size - 1];
+    // Points strictly above the line first-last can't be on the lower hull, and points strictly below it
+    // can't be on the upper hull, so each pass skips them after one batched orientation test.
+    // Points too close to the line to tell are kept, the chain's exact test decides for them.
+    for (size_t s = firstSpan; s <= lastSpan; ++s) { // Build lower hull
+        const Point* points = spans[s].data;
+        for (size_t base = 0; base < spans[s].size; base += ORIENT_BLOCK) {
+            size_t batch = std::min<size_t>(ORIENT_BLOCK, spans[s].size - base);
+            orientSignPoints(points + base, batch, first, last, side);
+            for (size_t j = 0; j < batch; ++j) {
+                if (side[j] > 0) continue;
+                const Point& p = points[base + j];
+                while (stack.size() >= 2 && orient(stack[stack.size()-2], stack.back(), p) <= 0) stack.pop_back();
+                stack.push_back(p);
+            }
+        }
+    }
+    size_t t = stack.size() + 1;
+    for (size_t s = lastSpan + 1; s-- > firstSpan; ) { // Build upper hull, from the point before last down to first
+        const Point* points = spans[s].data;
+        size_t top = s == lastSpan ? spans[s].size - 1 : spans[s].size;
+        while (top > 0) {
+            size_t batch = std::min<size_t>(ORIENT_BLOCK, top);
+            size_t base = top - batch;
+            orientSignPoints(points + base, batch, first, last, side);
+            for (size_t j = batch; j-- > 0; ) {
+                if (side[j] < 0) continue;
+                const Point& p = points[base + j];
+                while (stack.size() >= t && orient(stack[stack.size()-2], stack.back(), p) <= 0) stack.pop_back();
+                stack.push_back(p);
+            }
+            top = base;
+        }
+    }
+    stack.pop_back(); // Remove the last point as it is the same as the first one
+    hull.size = stack.size();
+}
+
+void monotoneChain(const Point* points, size_t n, ConvexHull& hull) {
+    PointSpan all = {points, n};
+    monotoneChain(&all, 1, hull);
+}
+
+/**
+ * @brief Sort a range with the radix sort when there is a scratch buffer, std::sort otherwise.
+ * Above --parallel-cutoff points the radix sort becomes a sample sort on the hull thread pool.
+ */
+static void sortRange(Point* begin, Point* end, Point* scratch) {
+    if (scratch && hull_pool && (size_t)(end - begin) >= hull_options.parallel_cutoff) {
+        parallelSortPoints(begin, end - begin, scratch, hull_pool);
+    } else if (scratch) {
+        radixSortPoints(begin, end - begin, scratch);
+    } else {
+        std::sort(begin, end);
+    }
+}
+
+size_t convexHullInPlace(Point* points, size_t n, Point* scratch) {
+    if (n < 2) return 0; // A single point has no hull, same as monotoneChain
+    size_t lo = 0, hi = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (points[i] < points[lo]) lo = i;
+        if (points[hi] < points[i]) hi = i;
+    }
+    const Point first = points[lo], last = points[hi];
+    if (!(first < last)) { // All the points are the same, same output as the monotone chain
+        points[1] = first;
+        return 2;
+    }
+
+    // [first | below first-last | last | above first-last | on the line]
+    std::swap(points[0], points[lo]);
+    if (hi == 0) hi = lo;
+    std::swap(points[n-1], points[hi]);
+    Point* below = points + 1;
+    Point* above = std::partition(below, points + n - 1, [&](const Point& p) { return orient(first, last, p) < 0; });
+    Point* online = std::partition(above, points + n - 1, [&](const Point& p) { return orient(first, last, p) > 0; });
+    std::swap(*above, points[n-1]); // last goes between the halves, the point it replaces to the tail
+    if (online != above) std::swap(*online, points[n-1]);
+    Point* upper = above + 1;
+    Point* end = online + 1;
+    sortRange(below, above, scratch);
+    sortRange(upper, end, scratch);
+    std::reverse(upper, end);
+
+    // Walking first, below, last, above goes counter clockwise around the hull, so one stack
+    // builds both chains. It is written over the points already read, which stays behind the
+    // point being read.
+    size_t k = 1;
+    for (Point* p = below; p <= above; ++p) { // Lower chain, ends with last
+        while (k >= 2 && orient(points[k-2], points[k-1], *p) <= 0) k--;
+        points[k++] = *p;
+    }
+    size_t t = k + 1;
+    for (Point* p = upper; p < end; ++p) { // Upper chain, back towards first
+        while (k >= t && orient(points[k-2], points[k-1], *p) <= 0) k--;
+        points[k++] = *p;
+    }
+    while (k >= t && orient(points[k-2], points[k-1], first) <= 0) k--; // first closes the polygon
+    return k;
+}
+
+/**
+ * @brief Build the lower and upper chains of sorted runs, both from left to right.
+ */
+static void buildChains(const PointSpan* spans, size_t count, std::vector<Point>& lower, std::vector<Point>& upper) {
+    lower.clear();
+    upper.clear();
+    for (size_t s = 0; s < count; ++s) {
+        for (size_t i = 0; i < spans[s].size; ++i) {
+            const Point& p = spans[s].data[i];
+            while (lower.size() >= 2 && orient(lower[lower.size()-2], lower.back(), p) <= 0) lower.pop_back();
+            lower.push_back(p);
+            while (upper.size() >= 2 && orient(upper[upper.size()-2], upper.back(), p) >= 0) upper.pop_back();
+            upper.push_back(p);
+        }
+    }
+}
+
+static void buildChains(const Point* points, size_t n, std::vector<Point>& lower, std::vector<Point>& upper) {
+    PointSpan all = {points, n};
+    buildChains(&all, 1, lower, upper);
+}
+
+/**
+ * @brief Join the chain of a slab with the chain of the slab on its right.
+ * Walks both ends towards the bridge (the common tangent) and keeps only the
+ * vertices outside it. sign is 1 for lower chains and -1 for upper chains.
+ */
+static void mergeChains(std::vector<Point>& left, const std::vector<Point>& right, int sign) {
+    size_t i = left.size() - 1, j = 0;
+    bool moved = true;
+    while (moved) {
+        moved = false;
+        while (i > 0 && sign * orient(left[i-1], left[i], right[j]) <= 0) { i--; moved = true; }
+        while (j + 1 < right.size() && sign * orient(left[i], right[j], right[j+1]) <= 0) { j++; moved = true; }
+    }
+    left.resize(i + 1);
+    left.insert(left.end(), right.begin() + j, right.end());
+}
+
+/**
+ * @brief Join the chains of slabs that follow each other in (x, y) order into one hull.
+ */
+static void joinSlabs(const std::vector<std::vector<Point>>& lowers, const std::vector<std::vector<Point>>& uppers, ConvexHull& hull) {
+    // Bridges, from the leftmost slab to the rightmost one
+    std::vector<Point> lower, upper;
+    for (size_t s = 0; s < lowers.size(); ++s) {
+        if (lowers[s].empty()) continue;
+        if (lower.empty()) {
+            lower = lowers[s];
+            upper = uppers[s];
+        } else {
+            mergeChains(lower, lowers[s], 1);
+            mergeChains(upper, uppers[s], -1);
+        }
+    }
+
+    // Same order as monotoneChain: lower chain, then the upper chain backwards without its ends
+    hull.points.assign(lower.begin(), lower.end());
+    for (size_t i = upper.size() - 1; i-- > 1; ) hull.points.push_back(upper[i]);
+    hull.size = hull.points.size();
+}
+
+void convexHullParallel(const std::vector<Point>& points, ConvexHull& hull, int threads) {
+    size_t n = points.size();
+    if (threads < 2 || n < (size_t)threads * 2) {
+        std::vector<Point> sorted(points);
+        radixSortPoints(sorted);
+        monotoneChain(sorted.data(), n, hull);
+        return;
+    }
+
+    // Splitters from a regular sample cut the points into slabs of about n/threads points,
+    // disjoint in (x, y) order, so each slab's hull can be joined to the next one by a bridge.
+    std::vector<Point> sample;
+    size_t step = std::max<size_t>(1, n / ((size_t)threads * 64));
+    for (size_t i = 0; i < n; i += step) sample.push_back(points[i]);
+    std::sort(sample.begin(), sample.end());
+    std::vector<Point> splitters;
+    for (int s = 1; s < threads; ++s) splitters.push_back(sample[sample.size() * s / threads]);
+    auto slabOf = [&](const Point& p) {
+        return (size_t)(std::upper_bound(splitters.begin(), splitters.end(), p) - splitters.begin());
+    };
+
+    // Count, then scatter every chunk of the input into the slabs
+    std::vector<std::vector<size_t>> counts(threads, std::vector<size_t>(threads, 0));
+    auto chunkBegin = [&](int t) { return n * t / threads; };
+    parallelFor(hull_pool, threads, [&](int t) {
+        for (size_t i = chunkBegin(t); i < chunkBegin(t + 1); ++i) counts[t][slabOf(points[i])]++;
+    });
+    std::vector<size_t> slabStart(threads + 1, 0);
+    std::vector<std::vector<size_t>> offsets(threads, std::vector<size_t>(threads, 0));
+    size_t pos = 0;
+    for (int s = 0; s < threads; ++s) {
+        slabStart[s] = pos;
+        for (int t = 0; t < threads; ++t) {
+            offsets[t][s] = pos;
+            pos += counts[t][s];
+        }
+    }
+    slabStart[threads] = n;
+    std::vector<Point> slabs(n);
+    parallelFor(hull_pool, threads, [&](int t) {
+        std::vector<size_t>& out = offsets[t];
+        for (size_t i = chunkBegin(t); i < chunkBegin(t + 1); ++i) slabs[out[slabOf(points[i])]++] = points[i];
+    });
+
+    // Local hulls
+    std::vector<std::vector<Point>> lowers(threads), uppers(threads);
+    parallelFor(hull_pool, threads, [&](int s) {
+        std::vector<Point> scratch(slabStart[s + 1] - slabStart[s]);
+        radixSortPoints(slabs.data() + slabStart[s], scratch.size(), scratch.data());
+        buildChains(slabs.data() + slabStart[s], slabStart[s + 1] - slabStart[s], lowers[s], uppers[s]);
+    });
+    joinSlabs(lowers, uppers, hull);
+}
+
+void convexHullParallel(const PointSpan* spans, size_t count, ConvexHull& hull, int threads) {
+    size_t n = 0;
+    for (size_t s = 0; s < count; ++s) n += spans[s].size;
+    if (threads < 2 || n < (size_t)threads * 2) {
+        monotoneChain(spans, count, hull);
+        return;
+    }
+
+    // Cut the runs into one slab of about n/threads points per thread. A slab boundary moves
+    // forward past the points equal to the last one before it, so copies never straddle two slabs.
+    std::vector<std::vector<PointSpan>> slabs(threads);
+    size_t run = 0, at = 0, pos = 0; // Next point: run, offset in the run, position in the whole input
+    const Point* prev = nullptr;
+    for (int t = 0; t < threads; ++t) {
+        size_t end = t + 1 == threads ? n : std::max(pos, n * (t + 1) / threads);
+        while (pos < n) {
+            if (at == spans[run].size) {
+                run++;
+                at = 0;
+                continue;
+            }
+            const Point* data = spans[run].data;
+            size_t take = 0;
+            if (pos < end) {
+                take = std::min(spans[run].size - at, end - pos);
+            } else {
+                while (at + take < spans[run].size && !(*prev < data[at + take])) take++;
+                if (take == 0) break;
+            }
+            slabs[t].push_back(PointSpan{data + at, take});
+            prev = &data[at + take - 1];
+            at += take;
+            pos += take;
+        }
+    }
+
+    // Local hulls, with the batched chain; its hull is split back into the two chains at the rightmost vertex
+    std::vector<std::vector<Point>> lowers(threads), uppers(threads);
+    parallelFor(hull_pool, threads, [&](int t) {
+        ConvexHull local;
+        monotoneChain(slabs[t].data(), slabs[t].size(), local);
+        const std::vector<Point>& h = local.points;
+        if (h.size() < 3) { // One point, copies of one point, or a segment: the plain chains handle them
+            buildChains(slabs[t].data(), slabs[t].size(), lowers[t], uppers[t]);
+            return;
+        }
+        size_t right = std::max_element(h.begin(), h.end()) - h.begin();
+        lowers[t].assign(h.begin(), h.begin() + right + 1);
+        uppers[t].assign(1, h[0]);
+        uppers[t].insert(uppers[t].end(), h.rbegin(), h.rend() - right);
+    });
+    joinSlabs(lowers, uppers, hull);
+}
+
+void setHullThreadPool(ThreadPool* pool) {
+    hull_pool = pool;
+}
+
+ThreadPool* hullThreadPool() {
+    return hull_pool;
+}
+
+/**
+ * @brief The point farthest outside the directed line a-b (most negative cross) in one range.
+ * Ties go to the point farthest along a-b, so the pick is a hull vertex (up to rounding), not a
+ * point in the middle of a hull edge.
+ */
+static size_t farthestInRange(const Point* pts, size_t begin, size_t end, const Point& a, const Point& b) {
+    size_t best = begin;
+    double bestCross = cross(a, b, pts[begin]);
+    double bestDot = (pts[begin].x - a.x) * (b.x - a.x) + (pts[begin].y - a.y) * (b.y - a.y);
+    for (size_t i = begin + 1; i < end; ++i) {
+        double c = cross(a, b, pts[i]);
+        if (c > bestCross) continue;
+        double d = (pts[i].x - a.x) * (b.x - a.x) + (pts[i].y - a.y) * (b.y - a.y);
+        if (c < bestCross || d > bestDot) {
+            best = i;
+            bestCross = c;
+            bestDot = d;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Same as farthestInRange over [0, n), split into contiguous chunks on the pool when n is large.
+ */
+static size_t farthestPoint(const Point* pts, size_t n, const Point& a, const Point& b, ThreadPool* pool) {
+    if (!pool || n < QUICKHULL_GRAIN * 2) return farthestInRange(pts, 0, n, a, b);
+    size_t chunks = std::min<size_t>(n / QUICKHULL_GRAIN, (size_t)pool->size() * 4);
+    std::vector<size_t> best(chunks);
+    TaskGroup group(pool);
+    for (size_t c = 0; c < chunks; ++c) {
+        group.run([&, c]() { best[c] = farthestInRange(pts, n * c / chunks, n * (c + 1) / chunks, a, b); });
+    }
+    group.wait();
+    size_t result = best[0];
+    for (size_t c = 1; c < chunks; ++c) { // Same tie-break as inside the chunks
+        double c1 = cross(a, b, pts[result]), c2 = cross(a, b, pts[best[c]]);
+        double d1 = (pts[result].x - a.x) * (b.x - a.x) + (pts[result].y - a.y) * (b.y - a.y);
+        double d2 = (pts[best[c]].x - a.x) * (b.x - a.x) + (pts[best[c]].y - a.y) * (b.y - a.y);
+        if (c2 < c1 || (c2 == c1 && d2 > d1)) result = best[c];
+    }
+    return result;
+}
+
+/**
+ * @brief QuickHull step: pts[0..n) are the points strictly right of a-b.
+ * Appends the hull vertices between a and b (exclusive), in order, to out.
+ * The two halves are partitioned in place and the bigger subproblems become tasks.
+ */
+static void quickHullStep(Point* pts, size_t n, const Point& a, const Point& b, std::vector<Point>& out, ThreadPool* pool) {
+    if (n == 0) return;
+    const Point c = pts[farthestPoint(pts, n, a, b, pool)];
+    // [right of a-c | right of c-b | inside the triangle a, c, b]
+    Point* mid = std::partition(pts, pts + n, [&](const Point& p) { return orient(a, c, p) < 0; });
+    Point* end = std::partition(mid, pts + n, [&](const Point& p) { return orient(c, b, p) < 0; });
+    size_t n1 = mid - pts, n2 = end - mid;
+
+    if (pool && n1 + n2 >= QUICKHULL_GRAIN && n1 > 0 && n2 > 0) {
+        std::vector<Point> left;
+        TaskGroup group(pool);
+        group.run([&]() { quickHullStep(pts, n1, a, c, left, pool); });
+        std::vector<Point> right;
+        quickHullStep(mid, n2, c, b, right, pool);
+        group.wait();
+        out.insert(out.end(), left.begin(), left.end());
+        out.push_back(c);
+        out.insert(out.end(), right.begin(), right.end());
+    } else {
+        quickHullStep(pts, n1, a, c, out, pool);
+        out.push_back(c);
+        quickHullStep(mid, n2, c, b, out, pool);
+    }
+}
+
+void convexHull_QuickHull(std::vector<Point> points, ConvexHull& hull) {
+    size_t n = points.size();
+    hull.points.clear();
+    hull.size = 0;
+    if (n == 0) return;
+    size_t lo = 0, hi = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (points[i] < points[lo]) lo = i;
+        if (points[hi] < points[i]) hi = i;
+    }
+    const Point a = points[lo], b = points[hi];
+    if (!(a < b)) { // All the points are the same, same output as the monotone chain
+        hull.points.assign(n >= 2 ? 2 : 0, a);
+        hull.size = hull.points.size();
+        return;
+    }
+    ThreadPool* pool = n >= hull_options.parallel_cutoff ? hull_pool : nullptr;
+
+    // [below a-b | above a-b | on the line]
+    Point* below = points.data();
+    Point* above = std::partition(below, below + n, [&](const Point& p) { return orient(a, b, p) < 0; });
+    Point* end = std::partition(above, below + n, [&](const Point& p) { return orient(a, b, p) > 0; });
+
+    std::vector<Point> lower, upper;
+    TaskGroup group(pool);
+    group.run([&]() { quickHullStep(below, above - below, a, b, lower, pool); });
+    quickHullStep(above, end - above, b, a, upper, pool);
+    group.wait();
+
+    // The farthest point is picked with a rounded cross product, so on nearly collinear input
+    // a pick can sit just inside the hull. Hull vertices are never dropped (only points inside
+    // a triangle of input points are), so an exact monotone chain over the few candidates
+    // removes the extra ones.
+    std::vector<Point> candidates;
+    candidates.reserve(lower.size() + upper.size() + 2);
+    candidates.push_back(a);
+    candidates.insert(candidates.end(), lower.begin(), lower.end());
+    candidates.push_back(b);
+    candidates.insert(candidates.end(), upper.begin(), upper.end());
+    std::sort(candidates.begin(), candidates.end());
+    monotoneChain(candidates.data(), candidates.size(), hull);
+}
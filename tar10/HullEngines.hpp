@@ -0,0 +1,106 @@
+#ifndef HULLENGINES_HPP
+#define HULLENGINES_HPP
+#include <vector>
+#include <cstddef>
+#include "ConvexHall.hpp"
+
+class ThreadPool;
+
+/**
+ * @brief A contiguous run of sorted points.
+ */
+typedef struct PointSpan{
+    const Point* data;
+    size_t size;
+} PointSpan;
+
+/**
+ * @brief Akl-Toussaint heuristic: drop the points that can't be hull vertices.
+ * Finds the extreme points in 8 directions (x, y, x+y, x-y) and discards every
+ * point strictly inside the polygon they form. The survivors are moved to the
+ * front of the vector and the discarded points to its tail (in no particular order).
+ * @param points The input points.
+ * @return The number of discarded points.
+ */
+size_t aklToussaintFilter(std::vector<Point>& points);
+
+/**
+ * @brief Same filter over sorted runs, copying the survivors out in order so they stay sorted.
+ * @param spans The runs.
+ * @param count The number of runs.
+ * @param kept Receives the points that can be hull vertices.
+ * @return The number of discarded points.
+ */
+size_t aklToussaintFilter(const PointSpan* spans, size_t count, std::vector<Point>& kept);
+
+/**
+ * @brief Andrew's monotone chain over points that are already sorted.
+ * @param points The sorted points (by x, then by y).
+ * @param n The number of points.
+ * @param hull The ConvexHull structure to store the result, counter clockwise from the first point.
+ */
+void monotoneChain(const Point* points, size_t n, ConvexHull& hull);
+
+/**
+ * @brief Same as monotoneChain over the concatenation of several runs, without joining them.
+ * @param spans The runs, each one sorted and every one after the previous (empty runs are skipped).
+ * @param count The number of runs.
+ * @param hull The ConvexHull structure to store the result.
+ */
+void monotoneChain(const PointSpan* spans, size_t count, ConvexHull& hull);
+
+/**
+ * @brief Monotone chain hull computed inside the input array, without allocating.
+ * The points are partitioned around the leftmost-rightmost line and only the two
+ * halves are sorted (the lower one ascending, the upper one descending), so both
+ * chains can be built over the array itself: the stack never passes the point being read.
+ * @param points The input points; they are reordered, and the hull is written to the front.
+ * @param n The number of points.
+ * @param scratch A buffer of n points for the radix sort, or nullptr to sort in place with std::sort.
+ * @return The number of hull vertices, in the same order as convexHull() gives them.
+ */
+size_t convexHullInPlace(Point* points, size_t n, Point* scratch);
+
+/**
+ * @brief Divide and conquer hull on several threads.
+ * The points are cut into one slab per thread by (x, y) order; the slabs are sorted and
+ * chained as tasks on the hull thread pool, then neighbouring slabs are joined by their bridges.
+ * Gives the same result as convexHull().
+ * @param points The input points.
+ * @param hull The ConvexHull structure to store the result.
+ * @param threads The number of worker threads.
+ */
+void convexHullParallel(const std::vector<Point>& points, ConvexHull& hull, int threads);
+
+/**
+ * @brief Same engine over runs that are already sorted: no scatter and no sort, each thread
+ * chains a contiguous part of the runs and the parts are joined by their bridges.
+ * @param spans The runs, as for monotoneChain.
+ * @param count The number of runs.
+ * @param hull The ConvexHull structure to store the result.
+ * @param threads The number of worker threads.
+ */
+void convexHullParallel(const PointSpan* spans, size_t count, ConvexHull& hull, int threads);
+
+/**
+ * @brief Set the pool the parallel engines run their tasks on.
+ * @param pool The pool, created once at server startup; nullptr runs everything serially.
+ */
+void setHullThreadPool(ThreadPool* pool);
+
+/**
+ * @brief The pool set by setHullThreadPool, or nullptr.
+ */
+ThreadPool* hullThreadPool();
+
+/**
+ * @brief Calculate the convex hull with QuickHull, same signature and result as convexHull().
+ * The points on each side of the leftmost-rightmost line are split recursively around the
+ * farthest point. Every subproblem is a contiguous range partitioned in place, and above
+ * --parallel-cutoff points the recursive calls run as tasks on the hull thread pool.
+ * @param points The input points.
+ * @param hull The ConvexHull structure to store the result.
+ */
+void convexHull_QuickHull(std::vector<Point> points, ConvexHull& hull);
+
+#endif
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <cmath>
+#include "HullQueries.hpp"
+#include "Predicates.hpp"
+
+/**
+ * @brief Whether q is on the closed segment a-b.
+ */
+static bool onSegment(const Point& a, const Point& b, const Point& q) {
+    return orient(a, b, q) == 0 &&
+           std::min(a.x, b.x) <= q.x && q.x <= std::max(a.x, b.x) &&
+           std::min(a.y, b.y) <= q.y && q.y <= std::max(a.y, b.y);
+}
+
+bool hullContains(const std::vector<Point>& hull, const Point& q) {
+    size_t h = hull.size();
+    if (h == 0) return false;
+    if (h < 3) return onSegment(hull.front(), hull.back(), q);
+    const Point& v0 = hull[0];
+    if (orient(v0, hull[1], q) < 0 || orient(v0, hull[h - 1], q) > 0) return false; // Outside the fan
+    size_t lo = 1, hi = h - 1; // q is between the rays v0-hull[lo] and v0-hull[hi]
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if (orient(v0, hull[mid], q) >= 0) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return orient(hull[lo], hull[lo + 1], q) >= 0;
+}
+
+/**
+ * @brief Per thread buffers of hullContainsBatch, reused across calls.
+ */
+typedef struct BatchScratch{
+    std::vector<double> ax, ay, bx, by, side;
+    std::vector<size_t> lo, hi;
+} BatchScratch;
+
+/**
+ * @brief Replace the sides a batched kernel left at 0 (uncertain) with the exact orientation.
+ */
+static void settleSides(BatchScratch& s, const PointsSoA& q, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (s.side[i] == 0) s.side[i] = orient2d(s.ax[i], s.ay[i], s.bx[i], s.by[i], q.x[i], q.y[i]);
+    }
+}
+
+void hullContainsBatch(const std::vector<Point>& hull, const PointsSoA& queries, std::vector<char>& inside) {
+    size_t n = queries.size();
+    size_t h = hull.size();
+    inside.assign(n, 0);
+    if (h < 3) {
+        for (size_t i = 0; i < n; ++i) inside[i] = hullContains(hull, Point{queries.x[i], queries.y[i]});
+        return;
+    }
+    static thread_local BatchScratch s;
+    const Point& v0 = hull[0];
+    s.ax.assign(n, v0.x);
+    s.ay.assign(n, v0.y);
+    s.bx.resize(n);
+    s.by.resize(n);
+    s.side.resize(n);
+    s.lo.assign(n, 1);
+    s.hi.assign(n, h - 1);
+
+    // Inside the fan: left of v0-hull[1] and right of v0-hull[h-1]
+    s.bx.assign(n, hull[1].x);
+    s.by.assign(n, hull[1].y);
+    orientSignPairs(s.ax.data(), s.ay.data(), s.bx.data(), s.by.data(), queries.x.data(), queries.y.data(), n, s.side.data());
+    settleSides(s, queries, n);
+    for (size_t i = 0; i < n; ++i) inside[i] = s.side[i] >= 0;
+    s.bx.assign(n, hull[h - 1].x);
+    s.by.assign(n, hull[h - 1].y);
+    orientSignPairs(s.ax.data(), s.ay.data(), s.bx.data(), s.by.data(), queries.x.data(), queries.y.data(), n, s.side.data());
+    settleSides(s, queries, n);
+    for (size_t i = 0; i < n; ++i) inside[i] &= s.side[i] <= 0;
+
+    // Binary search for the wedge, one batched step at a time. The ranges all start
+    // the same size, so they shrink together and a step never leaves one behind by more than one.
+    for (bool more = h > 3; more; ) {
+        for (size_t i = 0; i < n; ++i) {
+            const Point& m = hull[(s.lo[i] + s.hi[i]) / 2];
+            s.bx[i] = m.x;
+            s.by[i] = m.y;
+        }
+        orientSignPairs(s.ax.data(), s.ay.data(), s.bx.data(), s.by.data(), queries.x.data(), queries.y.data(), n, s.side.data());
+        settleSides(s, queries, n);
+        more = false;
+        for (size_t i = 0; i < n; ++i) {
+            if (s.hi[i] - s.lo[i] <= 1) continue; // Already down to its wedge
+            size_t mid = (s.lo[i] + s.hi[i]) / 2;
+            if (s.side[i] >= 0) {
+                s.lo[i] = mid;
+            } else {
+                s.hi[i] = mid;
+            }
+            more |= s.hi[i] - s.lo[i] > 1;
+        }
+    }
+
+    // The edge that closes each query's wedge
+    for (size_t i = 0; i < n; ++i) {
+        const Point& a = hull[s.lo[i]];
+        const Point& b = hull[s.lo[i] + 1];
+        s.ax[i] = a.x;
+        s.ay[i] = a.y;
+        s.bx[i] = b.x;
+        s.by[i] = b.y;
+    }
+    orientSignPairs(s.ax.data(), s.ay.data(), s.bx.data(), s.by.data(), queries.x.data(), queries.y.data(), n, s.side.data());
+    settleSides(s, queries, n);
+    for (size_t i = 0; i < n; ++i) inside[i] &= s.side[i] >= 0;
+}
+
+static double dot(const Point& u, const Point& v) {
+    return u.x * v.x + u.y * v.y;
+}
+
+static Point minus(const Point& a, const Point& b) {
+    return Point{a.x - b.x, a.y - b.y};
+}
+
+void hullMetrics(const std::vector<Point>& hull, HullMetrics& metrics) {
+    size_t h = hull.size();
+    metrics.perimeter = metrics.diameter = metrics.width = metrics.rect_area = 0.0;
+    if (h == 0) {
+        metrics.diameter_ends[0] = metrics.diameter_ends[1] = Point{0.0, 0.0};
+        std::fill(metrics.rect, metrics.rect + 4, Point{0.0, 0.0});
+        return;
+    }
+    if (h < 3) { // A segment (or a point): no area, no width
+        const Point& a = hull.front();
+        const Point& b = hull.back();
+        metrics.diameter = std::hypot(b.x - a.x, b.y - a.y);
+        metrics.perimeter = 2 * metrics.diameter;
+        metrics.diameter_ends[0] = a;
+        metrics.diameter_ends[1] = b;
+        metrics.rect[0] = metrics.rect[3] = a;
+        metrics.rect[1] = metrics.rect[2] = b;
+        return;
+    }
+
+    auto next = [h](size_t k) { return k + 1 == h ? 0 : k + 1; };
+    double best_diameter = -1.0; // Squared
+    double best_width = INFINITY;
+    double best_rect = INFINITY;
+    size_t far = 1, right = 1, left = 1; // Farthest from the edge, farthest along it, farthest back
+    for (size_t i = 0; i < h; ++i) {
+        const Point& a = hull[i];
+        const Point& b = hull[next(i)];
+        Point edge = minus(b, a);
+        double length = std::sqrt(dot(edge, edge));
+        metrics.perimeter += length;
+        Point u{edge.x / length, edge.y / length};
+        Point normal{-u.y, u.x}; // Towards the inside
+
+        if (i == 0) far = next(i);
+        while (cross(a, b, hull[next(far)]) > cross(a, b, hull[far])) far = next(far);
+        if (i == 0) right = next(i);
+        while (dot(minus(hull[next(right)], hull[right]), u) > 0) right = next(right);
+        if (i == 0) left = far;
+        while (dot(minus(hull[next(left)], hull[left]), u) < 0) left = next(left);
+
+        // The antipodal pairs of this edge are (a, far) and (b, far)
+        for (const Point* end : {&a, &b}) {
+            Point d = minus(hull[far], *end);
+            if (dot(d, d) > best_diameter) {
+                best_diameter = dot(d, d);
+                metrics.diameter_ends[0] = *end;
+                metrics.diameter_ends[1] = hull[far];
+            }
+        }
+
+        double height = dot(minus(hull[far], a), normal);
+        best_width = std::min(best_width, height);
+        double lo = dot(minus(hull[left], a), u);
+        double hi = dot(minus(hull[right], a), u);
+        double area = height * (hi - lo);
+        if (area < best_rect) {
+            best_rect = area;
+            metrics.rect[0] = Point{a.x + u.x * lo, a.y + u.y * lo};
+            metrics.rect[1] = Point{a.x + u.x * hi, a.y + u.y * hi};
+            metrics.rect[2] = Point{metrics.rect[1].x + normal.x * height, metrics.rect[1].y + normal.y * height};
+            metrics.rect[3] = Point{metrics.rect[0].x + normal.x * height, metrics.rect[0].y + normal.y * height};
+        }
+    }
+    metrics.diameter = std::sqrt(best_diameter);
+    metrics.width = best_width;
+    metrics.rect_area = best_rect;
+}
@@ -0,0 +1,50 @@
+#ifndef HULLQUERIES_HPP
+#define HULLQUERIES_HPP
+#include <vector>
+#include <cstddef>
+#include "ConvexHall.hpp"
+#include "PointsSoA.hpp"
+
+/**
+ * @brief Whether q is inside the hull or on its boundary, in O(log h).
+ * Binary search over the fan of triangles from the first vertex for the wedge that
+ * holds q, then one test against the wedge's hull edge. Hulls of fewer than 3
+ * vertices are treated as a segment (or a point).
+ * @param hull The hull vertices, counter clockwise (as built by convexHull).
+ * @param q The query point.
+ */
+bool hullContains(const std::vector<Point>& hull, const Point& q);
+
+/**
+ * @brief hullContains for a batch of points.
+ * Every query takes the same number of binary search steps, so each step runs as
+ * one batched orientation test over all the queries (see orientSignPairs).
+ * @param hull The hull vertices, counter clockwise.
+ * @param queries The query points.
+ * @param inside Receives 1 for the queries inside the hull or on its boundary, 0 for the others.
+ */
+void hullContainsBatch(const std::vector<Point>& hull, const PointsSoA& queries, std::vector<char>& inside);
+
+/**
+ * @brief The rotating calipers measures of one hull.
+ */
+typedef struct HullMetrics{
+    double perimeter;
+    double diameter;        // Largest distance between two hull vertices
+    Point diameter_ends[2]; // The farthest pair
+    double width;           // Smallest distance between two parallel lines enclosing the hull
+    double rect_area;       // Area of the smallest enclosing rectangle
+    Point rect[4];          // Its corners, counter clockwise
+} HullMetrics;
+
+/**
+ * @brief Compute the perimeter, diameter, minimum width and minimum area bounding rectangle in O(h).
+ * Rotating calipers: for every hull edge, the vertices farthest from it and farthest along it
+ * both ways only move forward, so each pointer goes around the hull once. One of the optimal
+ * rectangles has a side on a hull edge (Freeman and Shapira), and so does the minimum width.
+ * @param hull The hull vertices, counter clockwise.
+ * @param metrics Receives the measures.
+ */
+void hullMetrics(const std::vector<Point>& hull, HullMetrics& metrics);
+
+#endif
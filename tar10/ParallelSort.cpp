@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <vector>
+#include "ParallelSort.hpp"
+#include "RadixSort.hpp"
+#include "ThreadPool.hpp"
+
+void parallelSortPoints(Point* points, size_t n, Point* scratch, ThreadPool* pool) {
+    int threads = pool ? pool->size() + 1 : 1;
+    if (threads < 2 || n < (size_t)threads * SORT_MIN_PER_THREAD) {
+        radixSortPoints(points, n, scratch);
+        return;
+    }
+    int buckets = threads * SORT_BUCKETS_PER_THREAD;
+
+    std::vector<Point> sample;
+    size_t step = std::max<size_t>(1, n / ((size_t)buckets * SORT_SAMPLES_PER_BUCKET));
+    for (size_t i = 0; i < n; i += step) sample.push_back(points[i]);
+    std::sort(sample.begin(), sample.end());
+    std::vector<Point> splitters;
+    for (int b = 1; b < buckets; ++b) splitters.push_back(sample[sample.size() * b / buckets]);
+    auto bucketOf = [&](const Point& p) {
+        return (size_t)(std::upper_bound(splitters.begin(), splitters.end(), p) - splitters.begin());
+    };
+
+    // Count, then scatter every chunk of the input into the buckets of scratch
+    std::vector<std::vector<size_t>> counts(threads, std::vector<size_t>(buckets, 0));
+    auto chunkBegin = [&](int t) { return n * t / threads; };
+    parallelFor(pool, threads, [&](int t) {
+        for (size_t i = chunkBegin(t); i < chunkBegin(t + 1); ++i) counts[t][bucketOf(points[i])]++;
+    });
+    std::vector<size_t> bucketStart(buckets + 1, 0);
+    std::vector<std::vector<size_t>> offsets(threads, std::vector<size_t>(buckets, 0));
+    size_t pos = 0;
+    for (int b = 0; b < buckets; ++b) {
+        bucketStart[b] = pos;
+        for (int t = 0; t < threads; ++t) {
+            offsets[t][b] = pos;
+            pos += counts[t][b];
+        }
+    }
+    bucketStart[buckets] = n;
+    parallelFor(pool, threads, [&](int t) {
+        std::vector<size_t>& out = offsets[t];
+        for (size_t i = chunkBegin(t); i < chunkBegin(t + 1); ++i) scratch[out[bucketOf(points[i])]++] = points[i];
+    });
+
+    // Every bucket is sorted in scratch, with its own range of points as the radix buffer, then copied back
+    parallelFor(pool, buckets, [&](int b) {
+        size_t begin = bucketStart[b], size = bucketStart[b + 1] - begin;
+        radixSortPoints(scratch + begin, size, points + begin);
+        std::copy(scratch + begin, scratch + begin + size, points + begin);
+    });
+}
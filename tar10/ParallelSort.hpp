@@ -0,0 +1,24 @@
+#ifndef PARALLELSORT_HPP
+#define PARALLELSORT_HPP
+#include <cstddef>
+#include "ConvexHall.hpp"
+
+class ThreadPool;
+
+#define SORT_BUCKETS_PER_THREAD 4 // More buckets than threads, so uneven buckets still balance
+#define SORT_SAMPLES_PER_BUCKET 32
+#define SORT_MIN_PER_THREAD 16384 // Below this many points per thread the serial radix sort is used
+
+/**
+ * @brief Sort points by x, then by y (Point::operator<), with a sample sort on the pool.
+ * Splitters from a regular sample cut the input into buckets; every thread counts and
+ * scatters its chunk of the input into the buckets, then the buckets are radix sorted
+ * as separate tasks.
+ * @param points The points to sort.
+ * @param n The number of points.
+ * @param scratch A buffer of at least n points, its content is overwritten.
+ * @param pool The pool to run on (the calling thread helps); nullptr sorts on the calling thread.
+ */
+void parallelSortPoints(Point* points, size_t n, Point* scratch, ThreadPool* pool);
+
+#endif
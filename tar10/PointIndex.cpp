@@ -0,0 +1,147 @@
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include "PointIndex.hpp"
+
+#define INDEX_MIN_SLOTS 16
+
+/**
+ * @brief splitmix64 finalizer, spreads the coordinate bits over the whole word.
+ */
+static uint64_t mix(uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+static uint64_t bitsOf(double v) {
+    if (v == 0) v = 0.0; // -0.0 and 0.0 are the same coordinate
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+PointIndex::PointIndex():epsilon(0),slots(INDEX_MIN_SLOTS, 0),mask(INDEX_MIN_SLOTS - 1){
+}
+
+void PointIndex::reset(double epsilon) {
+    this->epsilon = epsilon;
+    clear();
+}
+
+void PointIndex::clear() {
+    entries.clear();
+    slots.assign(INDEX_MIN_SLOTS, 0);
+    mask = INDEX_MIN_SLOTS - 1;
+}
+
+void PointIndex::keyOf(const Point& p, uint64_t& kx, uint64_t& ky) const {
+    if (epsilon > 0) {
+        kx = (uint64_t)(int64_t)std::floor(p.x / epsilon);
+        ky = (uint64_t)(int64_t)std::floor(p.y / epsilon);
+    } else {
+        kx = bitsOf(p.x);
+        ky = bitsOf(p.y);
+    }
+}
+
+size_t PointIndex::home(uint64_t kx, uint64_t ky) const {
+    return mix(kx ^ mix(ky)) & mask;
+}
+
+size_t PointIndex::probe(uint64_t kx, uint64_t ky) const {
+    size_t i = home(kx, ky);
+    while (slots[i] != 0) {
+        const Entry& e = entries[slots[i] - 1];
+        if (e.kx == kx && e.ky == ky) return i;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+size_t PointIndex::find(const Point& p) const {
+    uint64_t kx, ky;
+    keyOf(p, kx, ky);
+    size_t own = probe(kx, ky);
+    if (epsilon <= 0) return own;
+    size_t best = own;
+    double best_distance = INFINITY;
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            size_t i = probe(kx + dx, ky + dy);
+            if (slots[i] == 0) continue;
+            const Point& q = entries[slots[i] - 1].point;
+            double distance = std::max(std::abs(q.x - p.x), std::abs(q.y - p.y));
+            if (distance <= epsilon && distance < best_distance) {
+                best = i;
+                best_distance = distance;
+            }
+        }
+    }
+    return best;
+}
+
+void PointIndex::reserve(size_t n) {
+    size_t size = INDEX_MIN_SLOTS;
+    while (size < 2 * n) size *= 2;
+    if (size <= slots.size()) return;
+    entries.reserve(n);
+    slots.assign(size, 0);
+    mask = size - 1;
+    for (size_t e = 0; e < entries.size(); ++e) {
+        slots[probe(entries[e].kx, entries[e].ky)] = e + 1;
+    }
+}
+
+void PointIndex::grow() {
+    reserve(slots.size()); // Twice the slots the current entries need
+}
+
+size_t PointIndex::insert(Point& p) {
+    uint64_t kx, ky;
+    keyOf(p, kx, ky);
+    size_t i = find(p);
+    if (slots[i] != 0) {
+        Entry& e = entries[slots[i] - 1];
+        p = e.point;
+        return e.count++;
+    }
+    if (2 * (entries.size() + 1) > slots.size()) {
+        grow();
+        i = probe(kx, ky);
+    }
+    entries.push_back(Entry{kx, ky, p, 1});
+    slots[i] = entries.size();
+    return 0;
+}
+
+bool PointIndex::erase(const Point& p, Point& stored, size_t& left) {
+    size_t i = find(p);
+    if (slots[i] == 0) return false;
+    size_t e = slots[i] - 1;
+    stored = entries[e].point;
+    left = --entries[e].count;
+    if (left > 0) return true;
+
+    // Shift the rest of the probe run back over the freed slot
+    for (size_t j = (i + 1) & mask; slots[j] != 0; j = (j + 1) & mask) {
+        const Entry& moved = entries[slots[j] - 1];
+        size_t h = home(moved.kx, moved.ky);
+        if (((j - h) & mask) >= ((j - i) & mask)) { // i lies on the probe path of the entry in j
+            slots[i] = slots[j];
+            i = j;
+        }
+    }
+    slots[i] = 0;
+
+    // Swap and pop the entry
+    size_t last = entries.size() - 1;
+    if (e != last) {
+        entries[e] = entries[last];
+        slots[probe(entries[e].kx, entries[e].ky)] = e + 1;
+    }
+    entries.pop_back();
+    return true;
+}
@@ -0,0 +1,69 @@
+#ifndef POINTINDEX_HPP
+#define POINTINDEX_HPP
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "ConvexHall.hpp"
+
+/**
+ * @brief Hash index of the graph points: how many copies of each point the graph holds.
+ *
+ * Open addressing with linear probing over a power of two table that is at most half
+ * full; the distinct points themselves are kept densely in entries, so a point that
+ * loses its last copy is removed by moving the last entry into its place, and its table
+ * slot by shifting the rest of its probe run back (no tombstones).
+ *
+ * With an epsilon, entries are keyed by their cell in a grid of that size, and a point
+ * matches the closest stored point within epsilon on both axes, which is in its cell or
+ * in one of the 8 around it. The first point stored stands for every later point that matches it.
+ */
+class PointIndex {
+    private:
+        typedef struct Entry{
+            uint64_t kx, ky; // Exact coordinate bits, or grid cell
+            Point point;     // The stored coordinates
+            size_t count;    // Copies in the graph
+        } Entry;
+
+        double epsilon;             // 0 for exact matching
+        std::vector<Entry> entries; // One per distinct point
+        std::vector<size_t> slots;  // Entry index + 1, 0 for an empty slot
+        size_t mask;
+
+        void keyOf(const Point& p, uint64_t& kx, uint64_t& ky) const;
+        size_t home(uint64_t kx, uint64_t ky) const;
+        // Slot holding the key, or the empty slot where the probe for it ends.
+        size_t probe(uint64_t kx, uint64_t ky) const;
+        // Slot of the stored point p matches, or of the empty slot for its key if there is none.
+        size_t find(const Point& p) const;
+        void grow();
+
+    public:
+        PointIndex();
+
+        /**
+         * @brief Set the matching mode and empty the index.
+         * @param epsilon Grid cell size, 0 to match exact coordinates only.
+         */
+        void reset(double epsilon);
+        void clear();
+        void reserve(size_t n);
+
+        /**
+         * @brief Count one more copy of p.
+         * @param p The new point; in epsilon mode it is replaced by the point already stored for its cell.
+         * @return The number of copies the graph held before this one (0 for a new point).
+         */
+        size_t insert(Point& p);
+
+        /**
+         * @brief Count one copy of p less.
+         * @param p The point to remove (any point of its cell in epsilon mode).
+         * @param stored Receives the stored coordinates of the removed copy.
+         * @param left Receives the number of copies left.
+         * @return false if the graph holds no such point.
+         */
+        bool erase(const Point& p, Point& stored, size_t& left);
+};
+
+#endif
@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <cmath>
+#include "PointsSoA.hpp"
+#include "Predicates.hpp"
+#if defined(__x86_64__) || defined(__i386__)
+#define SOA_X86
+#include <immintrin.h>
+#endif
+
+void toSoA(const std::vector<Point>& points, PointsSoA& soa) {
+    soa.x.resize(points.size());
+    soa.y.resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        soa.x[i] = points[i].x;
+        soa.y[i] = points[i].y;
+    }
+}
+
+/*
+ * The kernels below are built for the baseline target and pick their AVX2 body
+ * at run time, so the binary runs on any x86-64 and still uses the wide lanes
+ * where the CPU has them. Each vector body handles whole lanes and returns how
+ * many points it covered; the scalar loop of the caller does the rest.
+ */
+#ifdef SOA_X86
+static bool hasAvx2() {
+    static const bool avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+    return avx2;
+}
+
+__attribute__((target("avx2")))
+static size_t orientSignPointsAvx2(const Point* points, size_t n, const Point& a, double dx, double dy, double* out) {
+    size_t i = 0;
+    const double* xy = &points[0].x;
+    const __m256d vdx = _mm256_set1_pd(dx), vdy = _mm256_set1_pd(dy);
+    const __m256d vax = _mm256_set1_pd(a.x), vay = _mm256_set1_pd(a.y);
+    const __m256d err = _mm256_set1_pd(ORIENT_ERRBOUND);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    for (; i + 4 <= n; i += 4) {
+        __m256d p01 = _mm256_loadu_pd(xy + 2 * i), p23 = _mm256_loadu_pd(xy + 2 * i + 4);
+        __m256d x = _mm256_unpacklo_pd(p01, p23); // Lanes in the order of points 0, 2, 1, 3
+        __m256d y = _mm256_unpackhi_pd(p01, p23);
+        __m256d left = _mm256_mul_pd(vdx, _mm256_sub_pd(y, vay));
+        __m256d right = _mm256_mul_pd(vdy, _mm256_sub_pd(x, vax));
+        __m256d det = _mm256_sub_pd(left, right);
+        __m256d bound = _mm256_mul_pd(err, _mm256_add_pd(_mm256_andnot_pd(sign, left), _mm256_andnot_pd(sign, right)));
+        __m256d sure = _mm256_cmp_pd(_mm256_andnot_pd(sign, det), bound, _CMP_GT_OQ);
+        _mm256_storeu_pd(out + i, _mm256_permute4x64_pd(_mm256_and_pd(det, sure), 0xD8)); // Back to 0, 1, 2, 3
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t orientSignPairsAvx2(const double* ax, const double* ay, const double* bx, const double* by,
+                                  const double* x, const double* y, size_t n, double* out) {
+    size_t i = 0;
+    const __m256d err = _mm256_set1_pd(ORIENT_ERRBOUND);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    for (; i + 4 <= n; i += 4) {
+        __m256d vax = _mm256_loadu_pd(ax + i), vay = _mm256_loadu_pd(ay + i);
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(bx + i), vax);
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(by + i), vay);
+        __m256d left = _mm256_mul_pd(dx, _mm256_sub_pd(_mm256_loadu_pd(y + i), vay));
+        __m256d right = _mm256_mul_pd(dy, _mm256_sub_pd(_mm256_loadu_pd(x + i), vax));
+        __m256d det = _mm256_sub_pd(left, right);
+        __m256d bound = _mm256_mul_pd(err, _mm256_add_pd(_mm256_andnot_pd(sign, left), _mm256_andnot_pd(sign, right)));
+        __m256d sure = _mm256_cmp_pd(_mm256_andnot_pd(sign, det), bound, _CMP_GT_OQ);
+        _mm256_storeu_pd(out + i, _mm256_and_pd(det, sure));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t shoelaceSumAvx2(const double* x, const double* y, size_t last, double& area) {
+    size_t i = 0;
+    __m256d acc = _mm256_setzero_pd();
+    for (; i + 4 <= last; i += 4) {
+        __m256d x0 = _mm256_loadu_pd(x + i), y0 = _mm256_loadu_pd(y + i);
+        __m256d x1 = _mm256_loadu_pd(x + i + 1), y1 = _mm256_loadu_pd(y + i + 1);
+        acc = _mm256_add_pd(acc, _mm256_sub_pd(_mm256_mul_pd(x0, y1), _mm256_mul_pd(x1, y0)));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    area = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    return i;
+}
+#endif
+
+#ifdef __SSE2__
+static size_t orientSignPointsSse2(const Point* points, size_t n, const Point& a, double dx, double dy, double* out) {
+    size_t i = 0;
+    const double* xy = &points[0].x;
+    const __m128d vdx = _mm_set1_pd(dx), vdy = _mm_set1_pd(dy);
+    const __m128d vax = _mm_set1_pd(a.x), vay = _mm_set1_pd(a.y);
+    const __m128d err = _mm_set1_pd(ORIENT_ERRBOUND);
+    const __m128d sign = _mm_set1_pd(-0.0);
+    for (; i + 2 <= n; i += 2) {
+        __m128d p0 = _mm_loadu_pd(xy + 2 * i), p1 = _mm_loadu_pd(xy + 2 * i + 2);
+        __m128d left = _mm_mul_pd(vdx, _mm_sub_pd(_mm_unpackhi_pd(p0, p1), vay));
+        __m128d right = _mm_mul_pd(vdy, _mm_sub_pd(_mm_unpacklo_pd(p0, p1), vax));
+        __m128d det = _mm_sub_pd(left, right);
+        __m128d bound = _mm_mul_pd(err, _mm_add_pd(_mm_andnot_pd(sign, left), _mm_andnot_pd(sign, right)));
+        __m128d sure = _mm_cmpgt_pd(_mm_andnot_pd(sign, det), bound);
+        _mm_storeu_pd(out + i, _mm_and_pd(det, sure));
+    }
+    return i;
+}
+
+static size_t orientSignPairsSse2(const double* ax, const double* ay, const double* bx, const double* by,
+                                  const double* x, const double* y, size_t n, double* out) {
+    size_t i = 0;
+    const __m128d err = _mm_set1_pd(ORIENT_ERRBOUND);
+    const __m128d sign = _mm_set1_pd(-0.0);
+    for (; i + 2 <= n; i += 2) {
+        __m128d vax = _mm_loadu_pd(ax + i), vay = _mm_loadu_pd(ay + i);
+        __m128d dx = _mm_sub_pd(_mm_loadu_pd(bx + i), vax);
+        __m128d dy = _mm_sub_pd(_mm_loadu_pd(by + i), vay);
+        __m128d left = _mm_mul_pd(dx, _mm_sub_pd(_mm_loadu_pd(y + i), vay));
+        __m128d right = _mm_mul_pd(dy, _mm_sub_pd(_mm_loadu_pd(x + i), vax));
+        __m128d det = _mm_sub_pd(left, right);
+        __m128d bound = _mm_mul_pd(err, _mm_add_pd(_mm_andnot_pd(sign, left), _mm_andnot_pd(sign, right)));
+        __m128d sure = _mm_cmpgt_pd(_mm_andnot_pd(sign, det), bound);
+        _mm_storeu_pd(out + i, _mm_and_pd(det, sure));
+    }
+    return i;
+}
+
+static size_t shoelaceSumSse2(const double* x, const double* y, size_t last, double& area) {
+    size_t i = 0;
+    __m128d acc = _mm_setzero_pd();
+    for (; i + 2 <= last; i += 2) {
+        __m128d x0 = _mm_loadu_pd(x + i), y0 = _mm_loadu_pd(y + i);
+        __m128d x1 = _mm_loadu_pd(x + i + 1), y1 = _mm_loadu_pd(y + i + 1);
+        acc = _mm_add_pd(acc, _mm_sub_pd(_mm_mul_pd(x0, y1), _mm_mul_pd(x1, y0)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    area = lanes[0] + lanes[1];
+    return i;
+}
+#endif
+
+static_assert(sizeof(Point) == 2 * sizeof(double), "orientSignPoints reads Points as (x, y) pairs of doubles");
+
+void orientSignPoints(const Point* points, size_t n, const Point& a, const Point& b, double* out) {
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    size_t i = 0;
+#ifdef SOA_X86
+    if (hasAvx2()) i = orientSignPointsAvx2(points, n, a, dx, dy, out);
+#ifdef __SSE2__
+    else i = orientSignPointsSse2(points, n, a, dx, dy, out);
+#endif
+#endif
+    for (; i < n; ++i) {
+        double left = dx * (points[i].y - a.y);
+        double right = dy * (points[i].x - a.x);
+        double det = left - right;
+        out[i] = std::abs(det) > ORIENT_ERRBOUND * (std::abs(left) + std::abs(right)) ? det : 0.0;
+    }
+}
+
+void orientSignPairs(const double* ax, const double* ay, const double* bx, const double* by,
+                     const double* x, const double* y, size_t n, double* out) {
+    size_t i = 0;
+#ifdef SOA_X86
+    if (hasAvx2()) i = orientSignPairsAvx2(ax, ay, bx, by, x, y, n, out);
+#ifdef __SSE2__
+    else i = orientSignPairsSse2(ax, ay, bx, by, x, y, n, out);
+#endif
+#endif
+    for (; i < n; ++i) {
+        double left = (bx[i] - ax[i]) * (y[i] - ay[i]);
+        double right = (by[i] - ay[i]) * (x[i] - ax[i]);
+        double det = left - right;
+        out[i] = std::abs(det) > ORIENT_ERRBOUND * (std::abs(left) + std::abs(right)) ? det : 0.0;
+    }
+}
+
+double shoelaceArea(const double* x, const double* y, size_t n) {
+    if (n < 3) return 0.0;
+    double area = 0.0;
+    size_t i = 0;
+    const size_t last = n - 1; // The edge (n-1, 0) is added separately, no modulo in the loop
+#ifdef SOA_X86
+    if (hasAvx2()) i = shoelaceSumAvx2(x, y, last, area);
+#ifdef __SSE2__
+    else i = shoelaceSumSse2(x, y, last, area);
+#endif
+#endif
+    for (; i < last; ++i) {
+        area += x[i] * y[i + 1] - x[i + 1] * y[i];
+    }
+    area += x[last] * y[0] - x[0] * y[last];
+    return std::abs(area) / 2.0;
+}
+
+double shoelaceArea(const PointsSoA& poly) {
+    return shoelaceArea(poly.x.data(), poly.y.data(), poly.size());
+}
@@ -0,0 +1,56 @@
+#ifndef POINTSSOA_HPP
+#define POINTSSOA_HPP
+#include <vector>
+#include <cstddef>
+#include "ConvexHall.hpp"
+
+/**
+ * @brief Points stored as separate x and y arrays, so batches of coordinates
+ * can be loaded straight into SIMD registers.
+ */
+typedef struct PointsSoA{
+    std::vector<double> x;
+    std::vector<double> y;
+
+    size_t size() const { return x.size(); }
+} PointsSoA;
+
+/**
+ * @brief Copy points into a structure of arrays.
+ * @param points The input points.
+ * @param soa The container to fill (its capacity is reused).
+ */
+void toSoA(const std::vector<Point>& points, PointsSoA& soa);
+
+/**
+ * @brief Compute cross(a, b, p) for every point p of a batch, keeping only the results whose sign is certain.
+ * A cross product within the floating point error bound of 0 is written as 0,
+ * so a positive or negative output is always the exact orientation.
+ * The batch is read straight from the Points of the sorted stores the hull chain walks:
+ * the kernel splits the (x, y) pairs into x and y lanes in registers instead of copying them out.
+ * @param points The batch.
+ * @param n The number of points in the batch.
+ * @param a The start of the directed line.
+ * @param b The end of the directed line.
+ * @param out Receives the n results.
+ */
+void orientSignPoints(const Point* points, size_t n, const Point& a, const Point& b, double* out);
+
+/**
+ * @brief Like orientSignPoints, for x and y arrays, with its own directed line a[i]-b[i] for every point.
+ * out[i] is the orientation of (x[i], y[i]) relative to the line, or 0 when its sign is uncertain.
+ */
+void orientSignPairs(const double* ax, const double* ay, const double* bx, const double* by,
+                     const double* x, const double* y, size_t n, double* out);
+
+/**
+ * @brief Calculate the area of a polygon with the shoelace formula.
+ * @param x The x coordinates of the vertices, in order.
+ * @param y The y coordinates of the vertices, in order.
+ * @param n The number of vertices.
+ * @return The area of the polygon.
+ */
+double shoelaceArea(const double* x, const double* y, size_t n);
+double shoelaceArea(const PointsSoA& poly);
+
+#endif
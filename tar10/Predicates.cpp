@@ -0,0 +1,83 @@
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "Predicates.hpp"
+
+static const double EPSILON = std::numeric_limits<double>::epsilon() / 2; // 2^-53, half an ulp of 1
+static const double SPLITTER = 134217729.0;                              // 2^27 + 1, for Dekker's split
+
+const double ORIENT_ERRBOUND = (3.0 + 16.0 * EPSILON) * EPSILON;
+
+// a + b = x + y exactly, with x = fl(a + b)
+static inline void twoSum(double a, double b, double& x, double& y) {
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+// a = hi + lo, both halves with at most 26 significant bits
+static inline void split(double a, double& hi, double& lo) {
+    double c = SPLITTER * a;
+    double big = c - a;
+    hi = c - big;
+    lo = a - hi;
+}
+
+// a * b = x + y exactly, with x = fl(a * b)
+static inline void twoProduct(double a, double b, double& x, double& y) {
+    x = a * b;
+    double ahi, alo, bhi, blo;
+    split(a, ahi, alo);
+    split(b, bhi, blo);
+    double err1 = x - ahi * bhi;
+    double err2 = err1 - alo * bhi;
+    double err3 = err2 - ahi * blo;
+    y = alo * blo - err3;
+}
+
+// Adds b to the expansion e (components in increasing magnitude), dropping zeros
+static int growExpansion(int elen, const double* e, double b, double* h) {
+    double q = b;
+    int hindex = 0;
+    for (int i = 0; i < elen; ++i) {
+        double sum, err;
+        twoSum(q, e[i], sum, err);
+        q = sum;
+        if (err != 0.0) h[hindex++] = err;
+    }
+    if (q != 0.0 || hindex == 0) h[hindex++] = q;
+    return hindex;
+}
+
+/**
+ * @brief Exact sign of the orientation, for the rare inputs the filter can't decide.
+ * The determinant is expanded into six products of input coordinates
+ * (a.x*b.y - a.x*c.y - a.y*b.x + a.y*c.x + b.x*c.y - b.y*c.x), each product is
+ * split into two exact terms, and the twelve terms are summed as an expansion.
+ * The largest component of the expansion has the sign of the exact value.
+ */
+static double orient2dExact(double ax, double ay, double bx, double by, double cx, double cy) {
+    const double products[6][2] = {{ax, by}, {-ax, cy}, {-ay, bx}, {ay, cx}, {bx, cy}, {-by, cx}};
+    double e[16], h[16];
+    int elen = 0;
+    for (int i = 0; i < 6; ++i) {
+        double x, y;
+        twoProduct(products[i][0], products[i][1], x, y);
+        elen = growExpansion(elen, e, y, h);
+        std::copy(h, h + elen, e);
+        elen = growExpansion(elen, e, x, h);
+        std::copy(h, h + elen, e);
+    }
+    return e[elen - 1];
+}
+
+double orient2d(double ax, double ay, double bx, double by, double cx, double cy) {
+    double left = (bx - ax) * (cy - ay);
+    double right = (by - ay) * (cx - ax);
+    double det = left - right;
+    double bound = ORIENT_ERRBOUND * (std::abs(left) + std::abs(right));
+    if (det > bound || -det > bound) return det; // The common case: the sign is certain
+    if (bound == 0.0) return det;                 // Both products are exactly 0
+    return orient2dExact(ax, ay, bx, by, cx, cy);
+}
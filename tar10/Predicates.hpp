@@ -0,0 +1,32 @@
+#ifndef PREDICATES_HPP
+#define PREDICATES_HPP
+
+// Robust orientation test, after Shewchuk's "Adaptive Precision Floating-Point
+// Arithmetic and Fast Robust Geometric Predicates". Works on plain doubles so
+// every tar can use it with its own Point type.
+// Must be compiled without FMA contraction (-ffp-contract=off).
+
+/**
+ * @brief Relative error bound of the plain floating point orientation test.
+ * |computed - exact| <= ORIENT_ERRBOUND * (|left product| + |right product|).
+ */
+extern const double ORIENT_ERRBOUND;
+
+/**
+ * @brief Orientation of c relative to the directed line a-b.
+ * Same formula and sign as cross(a, b, c): positive if a, b, c turn counter clockwise,
+ * negative if clockwise, and 0 only if they are exactly collinear. The floating point
+ * result is returned when its sign is certain; otherwise the sign is computed exactly
+ * with expansion arithmetic.
+ */
+double orient2d(double ax, double ay, double bx, double by, double cx, double cy);
+
+/**
+ * @brief orient2d() for any point type with x and y members.
+ */
+template <typename P>
+inline double orient(const P& a, const P& b, const P& c) {
+    return orient2d(a.x, a.y, b.x, b.y, c.x, c.y);
+}
+
+#endif
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cmath>
+#include "QuantizedPoints.hpp"
+
+QuantizedPoints::QuantizedPoints():mode(COORD_DOUBLE),scale(1.0),sorted(true){
+}
+
+void QuantizedPoints::reset(CoordMode mode, double scale) {
+    this->mode = mode;
+    this->scale = scale;
+    clear();
+}
+
+void QuantizedPoints::clear() {
+    points32.clear();
+    points64.clear();
+    sorted = true;
+}
+
+size_t QuantizedPoints::size() const {
+    return mode == COORD_INT32 ? points32.size() : points64.size();
+}
+
+template <typename T>
+bool QuantizedPoints::quantize(double x, double y, QPoint<T>& q, long long limit) const {
+    double qx = std::nearbyint(x * scale);
+    double qy = std::nearbyint(y * scale);
+    // The negated test also rejects NaN
+    if (!(std::abs(qx) < (double)limit) || !(std::abs(qy) < (double)limit)) return false;
+    q.x = (T)qx;
+    q.y = (T)qy;
+    return true;
+}
+
+template <typename T>
+void QuantizedPoints::append(std::vector<QPoint<T>>& points, const QPoint<T>& q) {
+    if (sorted && !points.empty() && q < points.back()) sorted = false; // Points that arrive in order keep the store sorted
+    points.push_back(q);
+}
+
+template <typename T>
+bool QuantizedPoints::removeOne(std::vector<QPoint<T>>& points, const QPoint<T>& q) {
+    if (sorted) {
+        auto it = std::lower_bound(points.begin(), points.end(), q);
+        if (it == points.end() || !(*it == q)) return false;
+        points.erase(it);
+    } else {
+        auto it = std::find(points.begin(), points.end(), q);
+        if (it == points.end()) return false;
+        *it = points.back(); // The order is lost already, the last point fills the gap
+        points.pop_back();
+    }
+    return true;
+}
+
+bool QuantizedPoints::add(double x, double y) {
+    if (mode == COORD_INT32) {
+        Point32 q;
+        if (!quantize(x, y, q, QUANT32_LIMIT)) return false;
+        append(points32, q);
+    } else {
+        Point64 q;
+        if (!quantize(x, y, q, QUANT64_LIMIT)) return false;
+        append(points64, q);
+    }
+    return true;
+}
+
+bool QuantizedPoints::remove(double x, double y) {
+    if (mode == COORD_INT32) {
+        Point32 q;
+        return quantize(x, y, q, QUANT32_LIMIT) && removeOne(points32, q);
+    } else {
+        Point64 q;
+        return quantize(x, y, q, QUANT64_LIMIT) && removeOne(points64, q);
+    }
+}
+
+template <typename T>
+void QuantizedPoints::dequantize(const std::vector<QPoint<T>>& points, std::vector<Point>& out) const {
+    out.resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        out[i] = Point{points[i].x / scale, points[i].y / scale};
+    }
+}
+
+void QuantizedPoints::toPoints(std::vector<Point>& out) const {
+    if (mode == COORD_INT32) {
+        dequantize(points32, out);
+    } else {
+        dequantize(points64, out);
+    }
+}
+
+template <typename T>
+void QuantizedPoints::hullOf(std::vector<QPoint<T>>& points, ConvexHull& hull) {
+    size_t n = points.size();
+    if (n == 0) {
+        hull.points.clear();
+        hull.size = 0;
+        return;
+    }
+    if (!sorted) {
+        std::sort(points.begin(), points.end());
+        sorted = true;
+    }
+    std::vector<QPoint<T>> chain; // A stack, it only grows as far as the chains do
+    for (size_t i = 0; i < n; ++i) { // Build lower hull
+        while (chain.size() >= 2 && orientInt(chain[chain.size()-2], chain.back(), points[i]) <= 0) chain.pop_back();
+        chain.push_back(points[i]);
+    }
+    for (size_t i = n - 1, t = chain.size() + 1; i-- > 0; ) { // Build upper hull
+        while (chain.size() >= t && orientInt(chain[chain.size()-2], chain.back(), points[i]) <= 0) chain.pop_back();
+        chain.push_back(points[i]);
+    }
+    chain.pop_back(); // Remove the last point as it is the same as the first one
+    dequantize(chain, hull.points);
+    hull.size = hull.points.size();
+}
+
+void QuantizedPoints::hull(ConvexHull& hull) {
+    if (mode == COORD_INT32) {
+        hullOf(points32, hull);
+    } else {
+        hullOf(points64, hull);
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef QUANTIZEDPOINTS_HPP
+#define QUANTIZEDPOINTS_HPP
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "ConvexHall.hpp"
+
+#define QUANT32_LIMIT (1LL << 30) // Differences fit in 32 bits, so orientation fits in int64
+#define QUANT64_LIMIT (1LL << 62) // Differences fit in 64 bits, so orientation fits in __int128
+
+/**
+ * @brief A fixed point coordinate pair: the real point is (x / scale, y / scale).
+ */
+template <typename T>
+struct QPoint{
+    T x;
+    T y;
+
+    bool operator<(const QPoint& other) const {
+        return x < other.x || (x == other.x && y < other.y);
+    }
+    bool operator==(const QPoint& other) const {
+        return x == other.x && y == other.y;
+    }
+};
+
+typedef QPoint<int32_t> Point32;
+typedef QPoint<int64_t> Point64;
+
+// Integer type wide enough for the exact orientation of QPoint<T>
+template <typename T> struct WideInt;
+template <> struct WideInt<int32_t> { typedef int64_t type; };
+template <> struct WideInt<int64_t> { typedef __int128 type; };
+
+/**
+ * @brief Exact orientation of c relative to the directed line a-b, same sign as cross().
+ * With the coordinates inside the mode's limit no product or difference can overflow,
+ * so there is no rounding and no error bound to check.
+ */
+template <typename T>
+inline typename WideInt<T>::type orientInt(const QPoint<T>& a, const QPoint<T>& b, const QPoint<T>& c) {
+    typedef typename WideInt<T>::type W;
+    return ((W)b.x - a.x) * ((W)c.y - a.y) - ((W)b.y - a.y) * ((W)c.x - a.x);
+}
+
+/**
+ * @brief Graph points stored as int32 or int64 fixed point coordinates.
+ *
+ * Used instead of graph.points when the server runs with --coords int32|int64.
+ * Points are rounded to the nearest multiple of 1/scale on the way in, and the
+ * hull is computed on the integers with orientInt(), so it is exact for the
+ * rounded points. An int32 point takes 8 bytes instead of the 16 of a Point.
+ * The points are sorted in place by the first hull after a change, so a rebuild
+ * needs no copy of the store, and removals binary search it while it stays sorted.
+ */
+class QuantizedPoints {
+    private:
+        CoordMode mode;
+        double scale;
+        std::vector<Point32> points32; // Used in COORD_INT32 mode
+        std::vector<Point64> points64; // Used in COORD_INT64 mode
+        bool sorted;                   // Whether the points of the mode are in QPoint order
+
+        template <typename T>
+        bool quantize(double x, double y, QPoint<T>& q, long long limit) const;
+        template <typename T>
+        void dequantize(const std::vector<QPoint<T>>& points, std::vector<Point>& out) const;
+        template <typename T>
+        void append(std::vector<QPoint<T>>& points, const QPoint<T>& q);
+        template <typename T>
+        bool removeOne(std::vector<QPoint<T>>& points, const QPoint<T>& q);
+        template <typename T>
+        void hullOf(std::vector<QPoint<T>>& points, ConvexHull& hull);
+
+    public:
+        QuantizedPoints();
+
+        // Selects the storage and clears the points; COORD_DOUBLE disables the store.
+        void reset(CoordMode mode, double scale);
+        bool enabled() const { return mode != COORD_DOUBLE; }
+        void clear();
+        size_t size() const;
+
+        /**
+         * @brief Round a point to the grid and store it.
+         * @return false if the point is not finite or is outside the range of the mode.
+         */
+        bool add(double x, double y);
+
+        /**
+         * @brief Remove one stored point that rounds to the same grid point as (x, y).
+         * @return false if there was no such point.
+         */
+        bool remove(double x, double y);
+
+        /**
+         * @brief The stored points, converted back to doubles.
+         */
+        void toPoints(std::vector<Point>& out) const;
+
+        /**
+         * @brief Monotone chain hull of the stored points, with exact integer orientation tests.
+         * Same order and conventions as convexHull(), the vertices converted back to doubles.
+         * Sorts the store in place if a change left it unsorted.
+         */
+        void hull(ConvexHull& hull);
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef RADIXSORT_HPP
+#define RADIXSORT_HPP
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Header only, so any point type with double x and y (and any tar) can use it.
+
+#define RADIX_BITS 11
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES 6        // 6 * 11 bits cover a 64 bit key
+#define RADIX_MIN_POINTS 1024  // Below this std::sort is faster
+
+/**
+ * @brief Map a double to an unsigned key with the same order.
+ * Positive numbers get their sign bit set, negative numbers have all their bits flipped.
+ * -0.0 and 0.0 compare equal, so they get the same key.
+ */
+inline uint64_t radixKey(double v) {
+    v += 0.0; // -0.0 + 0.0 == +0.0
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+}
+
+/**
+ * @brief Sort points by x, then by y (the order of Point::operator<).
+ * LSD radix sort of the x keys, 11 bits per pass; passes where every point falls
+ * into the same bucket are skipped. Runs of equal x are then sorted by y.
+ * @param points The points to sort.
+ * @param n The number of points.
+ * @param scratch A buffer of at least n points, its content is overwritten.
+ */
+template <typename P>
+void radixSortPoints(P* points, size_t n, P* scratch) {
+    if (n < RADIX_MIN_POINTS) {
+        std::sort(points, points + n);
+        return;
+    }
+    static thread_local std::vector<size_t> counts; // Reused, the sort doesn't allocate after the first call
+    counts.assign((size_t)RADIX_PASSES * RADIX_BUCKETS, 0);
+    auto digit = [](const P& p, int pass) {
+        return (size_t)((radixKey(p.x) >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1));
+    };
+    for (size_t i = 0; i < n; ++i) { // All the histograms in one read
+        uint64_t key = radixKey(points[i].x);
+        for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+            counts[(size_t)pass * RADIX_BUCKETS + ((key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1))]++;
+        }
+    }
+
+    P* src = points;
+    P* dst = scratch;
+    for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+        size_t* count = &counts[(size_t)pass * RADIX_BUCKETS];
+        if (count[digit(src[0], pass)] == n) continue; // Every point has the same digit
+        size_t sum = 0;
+        for (size_t b = 0; b < RADIX_BUCKETS; ++b) { // Counts become start offsets
+            size_t c = count[b];
+            count[b] = sum;
+            sum += c;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            dst[count[digit(src[i], pass)]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    if (src != points) std::copy(src, src + n, points);
+
+    for (size_t i = 0; i < n; ) { // Points with the same x are ordered by y
+        size_t j = i + 1;
+        while (j < n && points[j].x == points[i].x) ++j;
+        if (j - i > 1) std::sort(points + i, points + j, [](const P& a, const P& b) { return a.y < b.y; });
+        i = j;
+    }
+}
+
+/**
+ * @brief Sort a vector of points with radixSortPoints, using a temporary buffer.
+ * @param points The points to sort.
+ */
+template <typename P>
+void radixSortPoints(std::vector<P>& points) {
+    if (points.size() < RADIX_MIN_POINTS) {
+        std::sort(points.begin(), points.end());
+        return;
+    }
+    std::vector<P> scratch(points.size());
+    radixSortPoints(points.data(), points.size(), scratch.data());
+}
+
+#endif
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include "SlidingHull.hpp"
+#include "HullEngines.hpp"
+
+/**
+ * @brief Replace points by the vertices of their hull (or their first point when they have no hull).
+ */
+static void reduceToHull(std::vector<Point>& points) {
+    if (points.empty()) return;
+    std::sort(points.begin(), points.end());
+    ConvexHull tmp;
+    monotoneChain(points.data(), points.size(), tmp);
+    if (tmp.points.empty()) {
+        points.resize(1); // A single distinct point still bounds the older chunks
+    } else {
+        points.swap(tmp.points);
+    }
+}
+
+SlidingHull::SlidingHull():max_points(0),max_seconds(0),front_pos(0){
+    back_hull.rebuild(SortedPoints());
+}
+
+void SlidingHull::reset(size_t max_points, double max_seconds) {
+    this->max_points = max_points;
+    this->max_seconds = max_seconds;
+    clear();
+}
+
+void SlidingHull::clear() {
+    front.clear();
+    front_pos = 0;
+    front_suffix.clear();
+    back.clear();
+    back_hull.rebuild(SortedPoints());
+}
+
+void SlidingHull::add(const Point& p) {
+    back.push_back(Stamped{p, Clock::now()});
+    back_hull.insert(p);
+}
+
+void SlidingHull::flip() {
+    front.swap(back);
+    back.clear();
+    back_hull.rebuild(SortedPoints());
+    front_pos = 0;
+    size_t chunks = (front.size() + WINDOW_CHUNK - 1) / WINDOW_CHUNK;
+    front_suffix.resize(chunks + 1);
+    front_suffix[chunks].clear();
+    for (size_t c = chunks; c-- > 0; ) { // Newest chunk first, each on top of the next suffix hull
+        std::vector<Point>& suffix = front_suffix[c];
+        suffix = front_suffix[c + 1];
+        size_t end = std::min(front.size(), (c + 1) * WINDOW_CHUNK);
+        for (size_t i = c * WINDOW_CHUNK; i < end; ++i) suffix.push_back(front[i].point);
+        reduceToHull(suffix);
+    }
+}
+
+void SlidingHull::popFront() {
+    if (front_pos == front.size()) flip();
+    front_pos++;
+}
+
+size_t SlidingHull::expire() {
+    size_t dropped = 0;
+    while (max_points > 0 && size() > max_points) {
+        popFront();
+        dropped++;
+    }
+    if (max_seconds > 0) {
+        Clock::time_point oldest = Clock::now() - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(max_seconds));
+        while (size() > 0) {
+            if (front_pos == front.size()) flip();
+            if (front[front_pos].time >= oldest) break;
+            front_pos++;
+            dropped++;
+        }
+    }
+    return dropped;
+}
+
+void SlidingHull::toPoints(std::vector<Point>& out) const {
+    out.clear();
+    out.reserve(size());
+    for (size_t i = front_pos; i < front.size(); ++i) out.push_back(front[i].point);
+    for (const Stamped& s : back) out.push_back(s.point);
+}
+
+void SlidingHull::hull(ConvexHull& hull) const {
+    std::vector<Point> candidates;
+    if (front_pos < front.size()) { // The live part of the oldest chunk, then the hull of the newer chunks
+        size_t chunk = front_pos / WINDOW_CHUNK;
+        size_t end = std::min(front.size(), (chunk + 1) * WINDOW_CHUNK);
+        for (size_t i = front_pos; i < end; ++i) candidates.push_back(front[i].point);
+        candidates.insert(candidates.end(), front_suffix[chunk + 1].begin(), front_suffix[chunk + 1].end());
+    }
+    if (!back.empty()) {
+        ConvexHull tmp;
+        back_hull.toHull(tmp);
+        if (tmp.points.empty()) {
+            candidates.push_back(back.front().point); // All the back points are the same point
+        } else {
+            candidates.insert(candidates.end(), tmp.points.begin(), tmp.points.end());
+        }
+    }
+    convexHull(candidates, hull); // Unsorted, through the dispatcher
+    if (hull.points.empty() && size() >= 2) { // Every live point is the same; the candidates lost the copies
+        hull.points.assign(2, candidates.front());
+        hull.size = 2;
+    }
+}
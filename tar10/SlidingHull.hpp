@@ -0,0 +1,80 @@
+#ifndef SLIDINGHULL_HPP
+#define SLIDINGHULL_HPP
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include "ConvexHall.hpp"
+#include "DynamicHull.hpp"
+
+#define WINDOW_CHUNK 256 // Points per chunk of the front stack; one suffix hull is kept per chunk
+
+/**
+ * @brief The graph in window mode: the last N points, or the points of the last T seconds.
+ *
+ * A two-stack queue of points in arrival order. New points go on the back stack, whose
+ * hull is kept incrementally in a DynamicHull. Points expire from the front stack, which
+ * holds for every chunk of WINDOW_CHUNK points the hull of that chunk and of all the newer
+ * chunks in front. When the front runs out, the back is moved to the front and the suffix
+ * hulls are built from the newest chunk down, each from its chunk and the next suffix hull.
+ * A point expires in O(1) amortized, and the hull of the window comes from at most one
+ * partial chunk, one suffix hull and the back hull instead of every live point.
+ */
+class SlidingHull {
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        typedef struct Stamped{
+            Point point;
+            Clock::time_point time; // When the point was added
+        } Stamped;
+
+        size_t max_points;  // 0 for no count bound
+        double max_seconds; // 0 for no time bound
+
+        std::vector<Stamped> front;                   // Oldest first
+        size_t front_pos;                             // First live point of front
+        std::vector<std::vector<Point>> front_suffix; // Hull of front chunks c and later (one extra empty entry at the end)
+        std::vector<Stamped> back;                    // Added since the last flip, oldest first
+        DynamicHull back_hull;
+
+        // Moves the back stack to the front and builds the suffix hulls.
+        void flip();
+        // Drops the oldest point.
+        void popFront();
+
+    public:
+        SlidingHull();
+
+        /**
+         * @brief Set the bounds of the window. Both 0 leaves window mode off.
+         */
+        void reset(size_t max_points, double max_seconds);
+        bool enabled() const { return max_points > 0 || max_seconds > 0; }
+        bool expiresByTime() const { return max_seconds > 0; }
+
+        void clear();
+        size_t size() const { return front.size() - front_pos + back.size(); }
+
+        /**
+         * @brief Add a point, stamped with the current time.
+         */
+        void add(const Point& p);
+
+        /**
+         * @brief Drop the points beyond the count bound and the points older than the time bound.
+         * @return The number of points dropped.
+         */
+        size_t expire();
+
+        /**
+         * @brief Copy the live points, oldest first.
+         */
+        void toPoints(std::vector<Point>& out) const;
+
+        /**
+         * @brief Compute the hull of the live points, in the same order as convexHull() does.
+         */
+        void hull(ConvexHull& hull) const;
+};
+
+#endif
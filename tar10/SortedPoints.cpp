@@ -0,0 +1,92 @@
+#include <algorithm>
+#include "SortedPoints.hpp"
+#include "RadixSort.hpp"
+#include "ParallelSort.hpp"
+
+SortedPoints::SortedPoints():count(0){
+}
+
+void SortedPoints::clear() {
+    blocks.clear();
+    count = 0;
+}
+
+size_t SortedPoints::blockOf(const Point& p) const {
+    auto it = std::lower_bound(blocks.begin(), blocks.end(), p,
+        [](const std::vector<Point>& block, const Point& q) { return block.back() < q; });
+    if (it == blocks.end()) return blocks.size() - 1; // Above every point, goes at the end of the last block
+    return it - blocks.begin();
+}
+
+bool SortedPoints::assign(std::vector<Point>& points) {
+    bool presorted = std::is_sorted(points.begin(), points.end());
+    if (!presorted && hullThreadPool() && points.size() >= hull_options.parallel_cutoff) {
+        std::vector<Point> scratch(points.size());
+        parallelSortPoints(points.data(), points.size(), scratch.data(), hullThreadPool());
+    } else if (!presorted) {
+        radixSortPoints(points);
+    }
+    blocks.clear();
+    blocks.reserve((points.size() + SORTED_BLOCK - 1) / SORTED_BLOCK);
+    for (size_t i = 0; i < points.size(); i += SORTED_BLOCK) {
+        blocks.emplace_back(points.begin() + i, points.begin() + std::min(points.size(), i + SORTED_BLOCK));
+    }
+    count = points.size();
+    return presorted;
+}
+
+void SortedPoints::insert(const Point& p) {
+    count++;
+    if (blocks.empty()) {
+        blocks.emplace_back(1, p);
+        return;
+    }
+    size_t b = blockOf(p);
+    std::vector<Point>& block = blocks[b];
+    block.insert(std::upper_bound(block.begin(), block.end(), p), p);
+    if (block.size() >= 2 * SORTED_BLOCK) { // Split in two halves
+        std::vector<Point> upper(block.begin() + SORTED_BLOCK, block.end());
+        block.resize(SORTED_BLOCK);
+        blocks.insert(blocks.begin() + b + 1, std::move(upper));
+    }
+}
+
+size_t SortedPoints::erase(const Point& p) {
+    if (blocks.empty()) return 0;
+    size_t removed = 0;
+    size_t b = blockOf(p);
+    while (b < blocks.size()) { // Equal points can run over several blocks
+        std::vector<Point>& block = blocks[b];
+        auto range = std::equal_range(block.begin(), block.end(), p);
+        if (range.first == range.second) break;
+        bool last = range.second == block.end();
+        removed += range.second - range.first;
+        block.erase(range.first, range.second);
+        if (block.empty()) {
+            blocks.erase(blocks.begin() + b);
+        } else {
+            ++b;
+        }
+        if (!last) break;
+    }
+    count -= removed;
+    return removed;
+}
+
+bool SortedPoints::eraseOne(const Point& p) {
+    if (blocks.empty()) return false;
+    size_t b = blockOf(p); // The first block that can hold p, so it holds the first copy
+    std::vector<Point>& block = blocks[b];
+    auto it = std::lower_bound(block.begin(), block.end(), p);
+    if (it == block.end() || p < *it) return false;
+    block.erase(it);
+    if (block.empty()) blocks.erase(blocks.begin() + b);
+    count--;
+    return true;
+}
+
+void SortedPoints::spans(std::vector<PointSpan>& out) const {
+    out.clear();
+    out.reserve(blocks.size());
+    for (const auto& block : blocks) out.push_back(PointSpan{block.data(), block.size()});
+}
@@ -0,0 +1,88 @@
+#ifndef SORTEDPOINTS_HPP
+#define SORTEDPOINTS_HPP
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include "ConvexHall.hpp"
+#include "HullEngines.hpp"
+
+#define SORTED_BLOCK 1024 // Points per block after a split; a block is split when it reaches twice that
+
+/**
+ * @brief The graph points, kept sorted by Point::operator< in a blocked array.
+ *
+ * Each block is a small sorted vector and the blocks follow each other in order,
+ * so an insertion or a removal moves at most 2 * SORTED_BLOCK points, and the
+ * whole graph can be read in order without sorting (see spans()).
+ */
+class SortedPoints {
+    private:
+        std::vector<std::vector<Point>> blocks; // Never empty blocks
+        size_t count;
+
+        // Index of the block p belongs to (the first one whose last point is not below p).
+        size_t blockOf(const Point& p) const;
+
+    public:
+        SortedPoints();
+
+        void clear();
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        const Point& front() const { return blocks.front().front(); }
+
+        /**
+         * @brief Replace the content with points.
+         * The points are only sorted if they are not in order already.
+         * @return true if the points came in sorted.
+         */
+        bool assign(std::vector<Point>& points);
+
+        void insert(const Point& p);
+
+        /**
+         * @brief Remove every point equal to p.
+         * @return The number of points removed.
+         */
+        size_t erase(const Point& p);
+
+        /**
+         * @brief Remove one copy of p.
+         * @return false if there is none.
+         */
+        bool eraseOne(const Point& p);
+
+        /**
+         * @brief The blocks as runs of sorted points, for monotoneChain.
+         */
+        void spans(std::vector<PointSpan>& out) const;
+
+        /**
+         * @brief Call fn for every point q with lo < q < hi, in order.
+         */
+        template <typename Fn>
+        void forRange(const Point& lo, const Point& hi, Fn fn) const;
+
+        /**
+         * @brief Call fn for every point, in order.
+         */
+        template <typename Fn>
+        void forEach(Fn fn) const {
+            for (const auto& block : blocks) {
+                for (const Point& p : block) fn(p);
+            }
+        }
+};
+
+template <typename Fn>
+void SortedPoints::forRange(const Point& lo, const Point& hi, Fn fn) const {
+    for (size_t b = blocks.empty() ? 0 : blockOf(lo); b < blocks.size(); ++b) {
+        const std::vector<Point>& block = blocks[b];
+        for (auto it = std::upper_bound(block.begin(), block.end(), lo); it != block.end(); ++it) {
+            if (!(*it < hi)) return;
+            fn(*it);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,118 @@
+#include "ThreadPool.hpp"
+
+namespace {
+    thread_local const ThreadPool* worker_pool = nullptr; // Pool the calling thread works for
+    thread_local int worker_index = -1;
+}
+
+ThreadPool::ThreadPool(int threads):pending(0),next(0),stopping(false){
+    if (threads < 1) threads = 1;
+    for (int i = 0; i < threads; ++i) {
+        queues.emplace_back(new Queue());
+    }
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers) w.join();
+}
+
+int ThreadPool::currentWorker() const {
+    return worker_pool == this ? worker_index : -1;
+}
+
+void ThreadPool::submit(Task task) {
+    int index = currentWorker();
+    if (index < 0) index = next++ % queues.size();
+    {
+        // Counted before it is queued, so a thief never sees pending below zero.
+        // Taking sleep_mutex pairs with the wait in workerLoop, no lost wake-up.
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        pending++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+bool ThreadPool::popTask(int index, Task& task) {
+    size_t n = queues.size();
+    if (index >= 0) { // Own deque first, newest task
+        Queue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            pending--;
+            return true;
+        }
+    }
+    size_t start = index >= 0 ? index + 1 : next.load();
+    for (size_t k = 0; k < n; ++k) { // Steal the oldest task of another deque
+        Queue& victim = *queues[(start + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pending--;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::runOne() {
+    Task task;
+    if (!popTask(currentWorker(), task)) return false;
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(int index) {
+    worker_pool = this;
+    worker_index = index;
+    while (true) {
+        Task task;
+        if (popTask(index, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this] { return stopping || pending > 0; });
+        if (stopping) break;
+    }
+}
+
+TaskGroup::TaskGroup(ThreadPool* pool):pool(pool),running(0){
+}
+
+TaskGroup::~TaskGroup(){
+    wait();
+}
+
+void TaskGroup::run(Task task) {
+    if (!pool) {
+        task();
+        return;
+    }
+    running++;
+    pool->submit([this, task]() {
+        task();
+        running--;
+    });
+}
+
+void TaskGroup::wait() {
+    while (running > 0) {
+        if (!pool->runOne()) std::this_thread::yield();
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+typedef std::function<void()> Task;
+
+/**
+ * @brief Work-stealing thread pool.
+ * Every worker has its own deque: it pushes and pops its own tasks at the back
+ * (newest first, so recursive tasks stay cache-hot) and steals from the front of
+ * the other deques (oldest first, the biggest pieces of work) when it runs dry.
+ * Tasks submitted from outside the pool are spread over the deques round-robin.
+ */
+class ThreadPool {
+    private:
+        struct Queue {
+            std::deque<Task> tasks;
+            std::mutex mutex;
+        };
+        std::vector<std::unique_ptr<Queue>> queues; // One per worker
+        std::vector<std::thread> workers;
+        std::atomic<size_t> pending;  // Tasks submitted but not taken yet
+        std::atomic<size_t> next;     // Round-robin slot for outside submissions
+        std::atomic<bool> stopping;
+        std::mutex sleep_mutex;       // Idle workers wait on wake
+        std::condition_variable wake;
+
+        // Index of the calling thread's queue, or -1 outside this pool
+        int currentWorker() const;
+        void workerLoop(int index);
+        bool popTask(int index, Task& task);
+
+    public:
+        /**
+         * @brief Start the workers.
+         * @param threads The number of worker threads (at least 1).
+         */
+        explicit ThreadPool(int threads);
+        ~ThreadPool();
+
+        /**
+         * @brief Queue a task. From a worker it goes to that worker's own deque.
+         * @param task The task to run.
+         */
+        void submit(Task task);
+
+        /**
+         * @brief Run one queued task on the calling thread, if there is one.
+         * @return true if a task was run.
+         */
+        bool runOne();
+
+        /**
+         * @brief The number of worker threads.
+         */
+        int size() const { return (int)workers.size(); }
+};
+
+/**
+ * @brief Fork-join helper: run tasks on a pool and wait for all of them.
+ * The waiting thread keeps running queued tasks instead of blocking, so
+ * nested groups can't deadlock the pool.
+ */
+class TaskGroup {
+    private:
+        ThreadPool* pool;
+        std::atomic<int> running;
+
+    public:
+        /**
+         * @param pool The pool to run on; with nullptr the tasks run inline.
+         */
+        explicit TaskGroup(ThreadPool* pool);
+        ~TaskGroup();
+
+        /**
+         * @brief Start a task of this group.
+         */
+        void run(Task task);
+
+        /**
+         * @brief Wait until every task of this group finished.
+         */
+        void wait();
+};
+
+/**
+ * @brief Run fn(0) .. fn(parts-1) on the pool and wait for all of them.
+ * The calling thread runs the last part itself; with a null pool every part runs inline.
+ */
+template <typename Fn>
+void parallelFor(ThreadPool* pool, int parts, Fn fn) {
+    TaskGroup group(pool);
+    for (int t = 0; t + 1 < parts; ++t) {
+        group.run([&fn, t]() { fn(t); });
+    }
+    if (parts > 0) fn(parts - 1);
+    group.wait();
+}
+
+#endif
@@ -4,7 +4,14 @@
 #include <algorithm>
 #include <cmath>
 #include "ConvexHall.hpp"
+#include "../tar10/RadixSort.hpp"
+#include "../tar10/Predicates.hpp"
 #include <chrono>
+#include <string>
+
+bool use_prefilter = false;      // --prefilter: run aklToussaintFilter before Andrew's sort
+size_t prefilter_discarded = 0;  // Points dropped by the filter in the last convexHull_Androw call
+
 /**
  * @brief Culc the area of a polygon defined by the convex hull points.
  * @param poly The convex hull points.
@@ -22,6 +29,51 @@ double polygonArea(const ConvexHull& poly) {
     return std::abs(area) / 2.0;
 }
 
+/**
+ * @brief Akl-Toussaint heuristic: drop the points that can't be hull vertices.
+ * Finds the extreme points in 8 directions (x, y, x+y, x-y) and moves every point strictly
+ * inside the polygon they form to the tail of the vector.
+ * @param points The input points, survivors first on return.
+ * @return The number of discarded points.
+ */
+size_t aklToussaintFilter(std::vector<Point>& points) {
+    size_t n = points.size();
+    if (n < 8) return 0;
+
+    // Extreme points in counter clockwise order of direction, starting from the bottom
+    size_t ext[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (size_t i = 1; i < n; ++i) {
+        const Point& p = points[i];
+        if (p.y < points[ext[0]].y) ext[0] = i;                                   // min y
+        if (p.x - p.y > points[ext[1]].x - points[ext[1]].y) ext[1] = i;          // max x-y
+        if (p.x > points[ext[2]].x) ext[2] = i;                                   // max x
+        if (p.x + p.y > points[ext[3]].x + points[ext[3]].y) ext[3] = i;          // max x+y
+        if (p.y > points[ext[4]].y) ext[4] = i;                                   // max y
+        if (p.x - p.y < points[ext[5]].x - points[ext[5]].y) ext[5] = i;          // min x-y
+        if (p.x < points[ext[6]].x) ext[6] = i;                                   // min x
+        if (p.x + p.y < points[ext[7]].x + points[ext[7]].y) ext[7] = i;          // min x+y
+    }
+
+    Point poly[8];
+    int m = 0;
+    for (int i = 0; i < 8; ++i) { // Skip repeated corners, the same point can be extreme in several directions
+        const Point& p = points[ext[i]];
+        if (m > 0 && p.x == poly[m-1].x && p.y == poly[m-1].y) continue;
+        poly[m++] = p;
+    }
+    if (m > 1 && poly[0].x == poly[m-1].x && poly[0].y == poly[m-1].y) m--;
+    if (m < 3) return 0; // Flat input, nothing is strictly inside
+
+    auto inside = [&](const Point& p) {
+        for (int i = 0; i < m; ++i) {
+            if (orient(poly[i], poly[(i + 1) % m], p) <= 0) return false;
+        }
+        return true;
+    };
+    auto end = std::partition(points.begin(), points.end(), [&](const Point& p) { return !inside(p); });
+    return points.end() - end;
+}
+
 /**
  * @brief Calculate the convex hull of a set of points using the Andrew's monotone chain algorithm.
  * @param points The input points.
@@ -31,50 +83,215 @@ void convexHull_Androw(std::vector<Point>& points, ConvexHull& hull) {
    
     int n = points.size();
     int k = 0;
-    std::sort(points.begin(), points.end()); // Sort points (by x, then by y)
+    prefilter_discarded = use_prefilter ? aklToussaintFilter(points) : 0;
+    n -= prefilter_discarded; // Only the survivors at the front take part
+    std::vector<Point> scratch(n);
+    radixSortPoints(points.data(), n, scratch.data()); // Sort points (by x, then by y), same order as std::sort
     hull.points.resize(2 * n); // Prepare space for the convex hull points
     hull.size = 2 * n;
     for (int i = 0; i < n; ++i) { // Build lower hull
-        while (k >= 2 && cross(hull.points[k-2], hull.points[k-1], points[i]) <= 0) k--;
+        while (k >= 2 && orient(hull.points[k-2], hull.points[k-1], points[i]) <= 0) k--;
         hull.points[k++] = points[i];
     }
     for (int i = n-2, t = k+1; i >= 0; --i) { // Build upper hull
-        while (k >= t && cross(hull.points[k-2], hull.points[k-1], points[i]) <= 0) k--;
+        while (k >= t && orient(hull.points[k-2], hull.points[k-1], points[i]) <= 0) k--;
         hull.points[k++] = points[i];
     }
     hull.points.resize(k - 1); // Remove the last point as it is the same as the first one
     hull.size = k - 1;
 }
+/**
+ * @brief Lower and upper chains of sorted points, both from left to right.
+ */
+static void buildChains(const Point* points, size_t n, std::vector<Point>& lower, std::vector<Point>& upper) {
+    lower.clear();
+    upper.clear();
+    for (size_t i = 0; i < n; ++i) {
+        while (lower.size() >= 2 && orient(lower[lower.size()-2], lower.back(), points[i]) <= 0) lower.pop_back();
+        lower.push_back(points[i]);
+        while (upper.size() >= 2 && orient(upper[upper.size()-2], upper.back(), points[i]) >= 0) upper.pop_back();
+        upper.push_back(points[i]);
+    }
+}
+
+/**
+ * @brief Binary search for the tangent from p to a chain, among the chain vertices after p.
+ * sign is 1 for a lower chain (most clockwise vertex) and -1 for an upper chain.
+ * On collinear vertices the farthest one wins.
+ * @return The tangent vertex, or nullptr if no vertex comes after p.
+ */
+static const Point* chainTangent(const Point* begin, const Point* end, const Point& p, int sign) {
+    const Point* lo = std::upper_bound(begin, end, p);
+    if (lo == end) return nullptr;
+    const Point* hi = end - 1;
+    while (lo < hi) { // First vertex whose successor turns back the other way
+        const Point* mid = lo + (hi - lo) / 2;
+        if (sign * orient(p, mid[0], mid[1]) > 0) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+/**
+ * @brief Jarvis march over the chains of all groups, from first to last.
+ * The chains of the groups are stored one after the other in chains, group g
+ * in [starts[g], starts[g+1]).
+ * @return false if the chain needs more than maxSteps vertices.
+ */
+static bool wrapChain(const std::vector<Point>& chains, const std::vector<size_t>& starts, const Point& first,
+                      const Point& last, int sign, size_t maxSteps, std::vector<Point>& out) {
+    out.clear();
+    out.push_back(first);
+    Point p = first;
+    while (p < last) {
+        if (out.size() > maxSteps) return false;
+        bool found = false;
+        Point best = p;
+        for (size_t g = 0; g + 1 < starts.size(); ++g) {
+            const Point* q = chainTangent(chains.data() + starts[g], chains.data() + starts[g+1], p, sign);
+            if (!q) continue;
+            double c = found ? sign * orient(p, best, *q) : -1;
+            if (c < 0 || (c == 0 && best < *q)) { // More outward, or as outward but farther
+                best = *q;
+                found = true;
+            }
+        }
+        out.push_back(best);
+        p = best;
+    }
+    return true;
+}
+
+/**
+ * @brief Calculate the convex hull of a set of points using Chan's algorithm, O(n log h).
+ * Guesses the hull size m = 2^(2^t): the points are split into groups of m, each group's
+ * chains are built with the monotone chain, and a Jarvis march with binary-search tangents
+ * wraps the groups. If the hull has more than m vertices the next guess is tried.
+ * @param points The input points.
+ * @param hull The resulting convex hull, in the same order as convexHull_Androw.
+ */
+void convexHull_Chan(std::vector<Point>& points, ConvexHull& hull) {
+    size_t n = points.size();
+    hull.points.clear();
+    hull.size = 0;
+    if (n == 0) return;
+    Point first = points[0], last = points[0];
+    for (const Point& p : points) {
+        if (p < first) first = p;
+        if (last < p) last = p;
+    }
+    if (!(first < last)) { // All the points are the same, keep Andrew's output for it
+        hull.points.assign(n >= 2 ? 2 : 0, first);
+        hull.size = hull.points.size();
+        return;
+    }
+
+    std::vector<Point> work(points), lower, upper, groupLower, groupUpper;
+    std::vector<Point> lowers, uppers; // Chains of all the groups, one after the other
+    std::vector<size_t> lowerStarts, upperStarts;
+    for (int t = 1; ; ++t) {
+        size_t m = t >= 6 ? n : std::min<size_t>(n, (size_t)1 << (1 << t)); // 4, 16, 256, 65536, ...
+        lowers.clear();
+        uppers.clear();
+        lowerStarts.assign(1, 0);
+        upperStarts.assign(1, 0);
+        for (size_t begin = 0; begin < n; begin += m) {
+            size_t size = std::min(n - begin, m);
+            std::sort(work.begin() + begin, work.begin() + begin + size);
+            buildChains(work.data() + begin, size, groupLower, groupUpper);
+            lowers.insert(lowers.end(), groupLower.begin(), groupLower.end());
+            uppers.insert(uppers.end(), groupUpper.begin(), groupUpper.end());
+            lowerStarts.push_back(lowers.size());
+            upperStarts.push_back(uppers.size());
+        }
+        if (wrapChain(lowers, lowerStarts, first, last, 1, m, lower) &&
+            wrapChain(uppers, upperStarts, first, last, -1, m, upper)) break;
+    }
+
+    hull.points = lower; // Counter clockwise from the leftmost point, like convexHull_Androw
+    for (size_t i = upper.size() - 1; i-- > 1; ) hull.points.push_back(upper[i]);
+    hull.size = hull.points.size();
+}
+#define GRAHAM_KEY_TOLERANCE (64 * std::numeric_limits<double>::epsilon()) // Keys closer than this may be out of order
+
+/**
+ * @brief Sort key of a point for Graham's scan, computed once per point.
+ */
+typedef struct GrahamKey{
+    double x;    // Pseudo-angle around the pivot, in [0, 2), grows with the real angle
+    double y;    // L1 distance to the pivot, grows along a ray from the pivot
+    Point point;
+
+    bool operator<(const GrahamKey& other) const {
+        return x < other.x || (x == other.x && y < other.y);
+    }
+} GrahamKey;
+
+/**
+ * @brief Exact order of Graham's scan: by angle around the pivot, closer points first on a ray.
+ */
+static bool grahamBefore(const Point& pivot, const Point& a, const Point& b) {
+    double cp = orient(pivot, a, b);
+    if (cp == 0) {
+        double da = (a.x - pivot.x)*(a.x - pivot.x) + (a.y - pivot.y)*(a.y - pivot.y);
+        double db = (b.x - pivot.x)*(b.x - pivot.x) + (b.y - pivot.y)*(b.y - pivot.y);
+        return da < db;
+    }
+    return cp > 0;
+}
+
 /**
  * @brief Calculate the convex hull of a set of points using Graham's scan algorithm.
+ * Every point gets a pseudo-angle key (no multiplications, no trigonometry) and the keys
+ * are radix sorted. Rounding can only swap points whose keys are nearly equal, so each
+ * run of such keys is sorted again with the exact comparison.
  * @param points The input points.
  * @param hull The resulting convex hull.
  */
 void convexHull_Graham(std::vector<Point> &points,ConvexHull& hull){
-    int index = 0;
+    size_t n = points.size();
+    if (n < 3) { // Nothing to scan
+        hull.points = points;
+        hull.size = n;
+        return;
+    }
+    size_t index = 0;
     double minY = points[0].y;
-    for (int i = 1; i < points.size(); i++) {
+    for (size_t i = 1; i < n; i++) {
         if (points[i].y < minY || (points[i].y == minY && points[i].x < points[index].x)) {
             minY = points[i].y;
             index = i;
         }
     }
     std::swap(points[0], points[index]); // Move the point with the lowest y-coordinate to the front
-    std::sort(points.begin() + 1, points.end(), [&](const Point& a, const Point& b) {
-                double cp = cross(points[0], a, b);
-                if (cp == 0) {
-                    double da = (a.x - points[0].x)*(a.x - points[0].x) + (a.y - points[0].y)*(a.y - points[0].y);
-                    double db = (b.x - points[0].x)*(b.x - points[0].x) + (b.y - points[0].y)*(b.y - points[0].y);
-                    return da < db;
-                }
-                return cp > 0;
+    const Point pivot = points[0];
+
+    std::vector<GrahamKey> keys(n - 1);
+    for (size_t i = 1; i < n; ++i) { // Every point is above the pivot, or on its right at the same height
+        double dx = points[i].x - pivot.x;
+        double dy = points[i].y - pivot.y;
+        double l1 = std::abs(dx) + dy;
+        keys[i - 1] = GrahamKey{l1 == 0 ? 0.0 : 1.0 - dx / l1, l1, points[i]};
+    }
+    radixSortPoints(keys);
+    for (size_t i = 0; i < keys.size(); ) {
+        size_t j = i + 1;
+        while (j < keys.size() && keys[j].x - keys[j-1].x <= GRAHAM_KEY_TOLERANCE) ++j;
+        if (j - i > 1) {
+            std::sort(keys.begin() + i, keys.begin() + j, [&](const GrahamKey& a, const GrahamKey& b) {
+                return grahamBefore(pivot, a.point, b.point);
             });
+        }
+        i = j;
+    }
+    for (size_t i = 1; i < n; ++i) points[i] = keys[i - 1].point;
+
     std::vector<Point> stack;
     stack.push_back(points[0]);
     stack.push_back(points[1]);
     stack.push_back(points[2]);
     for (size_t i = 3; i < points.size(); ++i) {
-        while (stack.size() >= 2 && cross(stack[stack.size()-2], stack[stack.size()-1], points[i]) <= 0) {
+        while (stack.size() >= 2 && orient(stack[stack.size()-2], stack[stack.size()-1], points[i]) <= 0) {
             stack.pop_back();
         }
         stack.push_back(points[i]);
@@ -106,9 +323,19 @@ void printConvexHull(const ConvexHull& hull) {
 }
 
 int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--prefilter") {
+            use_prefilter = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--prefilter]" << std::endl;
+            return 1;
+        }
+    }
     ConvexHull points;
     ConvexHull hull1;
     ConvexHull hull2;
+    ConvexHull hull3;
 
     std::cout << "Convex Hall Algorithm Implementation" << std::endl;
     std::cout<< "Please enter the number of points: ";
@@ -155,6 +382,9 @@ int main(int argc, char* argv[]) {
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration = end - start;
     std::cout << "Convex Hull calculated using Andrew's algorithm in " << duration.count() << " seconds." << std::endl;
+    if (use_prefilter) {
+        std::cout << "Prefilter discarded " << prefilter_discarded << " of " << n << " points." << std::endl;
+    }
     std::cout<<std::endl;
 
     printConvexHull(hull1); // Print the convex hull points calculated by Andrew's algorithm
@@ -170,9 +400,21 @@ int main(int argc, char* argv[]) {
     printConvexHull(hull2); // Print the convex hull points calculated by Graham's algorithm
      std::cout<<std::endl;
 
+    start = std::chrono::high_resolution_clock::now();
+    convexHull_Chan(points.points, hull3); // Calculate the convex hull using Chan's algorithm
+    end = std::chrono::high_resolution_clock::now();
+    duration = end - start;
+    std::cout << "Convex Hull calculated using Chan's algorithm in " << duration.count() << " seconds." << std::endl;
+    std::cout<<std::endl;
+
+    printConvexHull(hull3); // Print the convex hull points calculated by Chan's algorithm
+    std::cout<<std::endl;
+
     hull1.area= polygonArea(hull1); // Calculate the area of the convex hull
     hull2.area= polygonArea(hull2); // Calculate the area of the convex hull
+    hull3.area= polygonArea(hull3); // Calculate the area of the convex hull
     std::cout << "Convex Hull Area with androw: " << hull1.area << std::endl;
     std::cout << "Convex Hull Area with graham: " << hull2.area << std::endl;
+    std::cout << "Convex Hull Area with chan: " << hull3.area << std::endl;
     return 0;
 }
\ No newline at end of file
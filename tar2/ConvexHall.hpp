@@ -1,6 +1,7 @@
 #ifndef CONVEXHALL_HPP
 #define CONVEXHALL_HPP
 #include <vector>
+#include <cstddef>
 typedef struct Point{
     double x;
     double y;
@@ -18,7 +19,9 @@ typedef struct ConvexHull{
 
 void printConvexHull(const ConvexHull& hull);
 double cross(const Point& p1, const Point& p2, const Point& p3);
+size_t aklToussaintFilter(std::vector<Point>& points);
 void convexHull_Androw(std::vector<Point>& points, ConvexHull& hull);
+void convexHull_Chan(std::vector<Point>& points, ConvexHull& hull);
 void convexHull_Graham(std::vector<Point>& points, ConvexHull& hull);
 double polygonArea(const std::vector<Point>& poly);
 #endif
\ No newline at end of file